@@ -2,7 +2,11 @@
 #define LED_H
 
 #include "hal_gpio.h"
+#include "hal_gpio_irq.h"
+#include "hal_gpio_debounce.h"
+#include "hal_gpio_pwm.h"
 #include "interrupt.h"
+#include "cpu.h"
 
 #define PORTF_PIN_0			0
 #define PORTF_PIN_1			1
@@ -16,8 +20,46 @@
 #define SWITCH_SW1_PIN			PORTF_PIN_4
 #define SWITCH_SW2_PIN			PORTF_PIN_0
 
+/*Debounce tick rate and long press time*/
+#define DEBOUNCE_TICK_HZ						200
+#define LONG_PRESS_TICKS						(DEBOUNCE_TICK_HZ * 1)
+
+/*Software PWM of the LEDs*/
+#define LED_PWM_TIMER								timer_0
+#define LED_PWM_HZ									200
+#define LED_MS_TO_FRAMES(ms)				(((uint32_t)(ms) * LED_PWM_HZ) / 1000)
+
+/*LED channels of the PWM*/
+#define LED_RED											0
+#define LED_BLUE										1
+#define LED_GREEN										2
+#define LED_NUM_CHANNELS						3
+
+/*enum for the led effects*/
+typedef enum{
+	
+	LED_EFFECT_STEADY,
+	LED_EFFECT_BLINK,
+	LED_EFFECT_BREATHE
+}led_effect_type;
+
+/*Effect played by one led, times in PWM periods*/
+typedef struct{
+	
+	uint8_t		effect;										/*type "led_effect_type"*/
+	uint8_t		level;										/*peak duty*/
+	uint32_t	on_frames;								/*blink on time, half of the breathing period*/
+	uint32_t	off_frames;								/*blink off time, half of the breathing period*/
+	uint32_t	start;										/*PWM period the effect started at*/
+	
+}led_command_t;
+
 void led_switch_init(void);
 void led_on(GPIOA_Type *GPIOx, int32_t pin_no);
 void led_off(GPIOA_Type *GPIOx, int32_t pin_no);
+void led_set_brightness(uint8_t led, uint8_t level);
+void led_blink(uint8_t led, uint8_t level, uint16_t on_ms, uint16_t off_ms);
+void led_breathe(uint8_t led, uint8_t level, uint16_t period_ms);
+void led_service(void);
 
 #endif
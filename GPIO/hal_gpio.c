@@ -1,7 +1,75 @@
 #include "stdint.h"
 #include "hal_gpio.h"
+#include "hw_bitband.h"
+#include "hal_udma.h"
+
+
+
+/*Base addresses of each port in the APB and AHB apertures*/
+static GPIOA_Type * const gpio_apb_ports[GPIO_NUM_PORTS] = {
+	GPIOA, GPIOB, GPIOC, GPIOD, GPIOE, GPIOF
+};
+
+static GPIOA_Type * const gpio_ahb_ports[GPIO_NUM_PORTS] = {
+	GPIOA_AHB, GPIOB_AHB, GPIOC_AHB, GPIOD_AHB, GPIOE_AHB, GPIOF_AHB
+};
+
+/*NVIC number of each port*/
+static const IRQn_Type gpio_port_irq[GPIO_NUM_PORTS] = {
+	GPIOA_IRQn, GPIOB_IRQn, GPIOC_IRQn, GPIOD_IRQn, GPIOE_IRQn, GPIOF_IRQn
+};
+
+/*uDMA channel of each port*/
+static const uint8_t gpio_port_dma_channel[GPIO_NUM_PORTS] = {
+	UDMA_CH4_GPIOA, UDMA_CH5_GPIOB, UDMA_CH6_GPIOC, UDMA_CH7_GPIOD, UDMA_CH14_GPIOE, UDMA_CH15_GPIOF
+};
+
+
+/**
+	* @brief  Enables the clock of a port and waits until the port is ready
+	* @param  port : port number of type "gpio_port_number"
+	* @retval None
+	*/
+void hal_gpio_enable_clock(gpio_port_number port){
+	
+	bitband_set(&SYSCTL->RCGCGPIO, port);
+	while(!bitband_read(&SYSCTL->PRGPIO, port));
+}
+
+/**
+	* @brief  Moves a port to the AHB aperture and returns its AHB base
+	* @param  port : port number of type "gpio_port_number"
+	* @retval GPIOA_Type* : AHB base address of the port
+	*/
+GPIOA_Type *hal_gpio_enable_ahb(gpio_port_number port){
+	
+	bitband_set(&SYSCTL->GPIOHBCTL, port);
+	
+	return gpio_ahb_ports[port];
+}
+
+/**
+	* @brief  Returns the base address a port currently answers on (AHB or APB)
+	* @param  port : port number of type "gpio_port_number"
+	* @retval GPIOA_Type* : base address of the port
+	*/
+GPIOA_Type *hal_gpio_get_port(gpio_port_number port){
+	
+	if(bitband_read(&SYSCTL->GPIOHBCTL, port))
+		return gpio_ahb_ports[port];
+	
+	return gpio_apb_ports[port];
+}
+
+/**
+	* @brief  Returns the NVIC number of a port
+	* @param  port : port number of type "gpio_port_number"
+	* @retval IRQn_Type : interrupt number of the port
+	*/
+IRQn_Type hal_gpio_get_irq(gpio_port_number port){
+	return gpio_port_irq[port];
+}
 
-		
 
 /**
 	* @brief  Initializes the gpio pin 
@@ -13,10 +81,156 @@ void hal_gpio_init(GPIOA_Type *GPIOx, gpio_pin_config_t *gpio_pin_config){
 		
 	hal_gpio_set_pin_mode(GPIOx, gpio_pin_config->pin, gpio_pin_config->mode);
 	
+	if(gpio_pin_config->drive_strength)
+		hal_gpio_configure_drive_strength(GPIOx, gpio_pin_config->pin, gpio_pin_config->drive_strength);
+	
+	if(gpio_pin_config->register_config)
+		hal_gpio_configure_register(GPIOx, gpio_pin_config->pin, gpio_pin_config->register_config);
+	
 	hal_gpio_configure_digital_functionality(GPIOx, gpio_pin_config->pin, gpio_pin_config->digital);
 	
 }
 
+/*Register image of one port, built from the board pin table*/
+typedef struct{
+
+	uint8_t		used;
+	uint8_t		dir;
+	uint8_t		afsel;
+	uint8_t		dr2r;
+	uint8_t		dr4r;
+	uint8_t		dr8r;
+	uint8_t		odr;
+	uint8_t		pur;
+	uint8_t		pdr;
+	uint8_t		den;
+	uint8_t		is;
+	uint8_t		ibe;
+	uint8_t		iev;
+	uint8_t		im;
+	uint32_t	pctl;
+	uint32_t	pctl_mask;
+
+}gpio_port_image_t;
+
+/**
+	* @brief  Adds one board pin to its port image
+	* @param  *image : image of the port the pin belongs to
+	* @param  *pin : board pin descriptor
+	* @retval None
+	*/
+static void hal_gpio_merge_pin(gpio_port_image_t *image, const gpio_board_pin_t *pin){
+	
+	uint8_t bit = (1 << pin->pin);
+	
+	image->used |= bit;
+	
+	if(pin->mode == GPIO_PIN_OUTPUT_MODE)
+		image->dir |= bit;
+	
+	if(pin->alt_function){
+		image->afsel |= bit;
+		image->pctl |= ((uint32_t)(pin->alt_function & 0x0F) << (pin->pin * 4));
+	}
+	image->pctl_mask |= (0x0FUL << (pin->pin * 4));
+	
+	if(pin->drive_strength == GPIO_PIN_DS_8MA)
+		image->dr8r |= bit;
+	else if(pin->drive_strength == GPIO_PIN_DS_4MA)
+		image->dr4r |= bit;
+	else
+		image->dr2r |= bit;
+	
+	if(pin->register_config == GPIO_PIN_PULL_UP)
+		image->pur |= bit;
+	else if(pin->register_config == GPIO_PIN_PULL_DOWN)
+		image->pdr |= bit;
+	else if(pin->register_config == GPIO_PIN_OPEN_DRAIN)
+		image->odr |= bit;
+	
+	if(pin->digital)
+		image->den |= bit;
+	
+	switch(pin->interrupt){
+		case GPIO_PIN_INT_RISING_EDGE:	image->iev |= bit;										break;
+		case GPIO_PIN_INT_FALLING_EDGE:																				break;
+		case GPIO_PIN_INT_BOTH_EDGES:		image->ibe |= bit;										break;
+		case GPIO_PIN_INT_LOW_LEVEL:		image->is |= bit;										break;
+		case GPIO_PIN_INT_HIGH_LEVEL:		image->is |= bit; image->iev |= bit;	break;
+		default:																															return;
+	}
+	
+	image->im |= bit;
+}
+
+/**
+	* @brief  Writes one port image, each register exactly once
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  *image : image of the port
+	* @retval None
+	*/
+static void hal_gpio_write_port_image(GPIOA_Type *GPIOx, const gpio_port_image_t *image){
+	
+	uint32_t keep = ~(uint32_t)image->used;
+	
+	/*Allow changes to locked pins (PC0-3, PD7, PF0) of this table,
+	 *pins committed earlier keep their commit*/
+	GPIOx->LOCK = GPIO_LOCK_KEY;
+	GPIOx->CR |= image->used;
+	
+	GPIOx->DIR = (GPIOx->DIR & keep) | image->dir;
+	GPIOx->AFSEL = (GPIOx->AFSEL & keep) | image->afsel;
+	GPIOx->PCTL = (GPIOx->PCTL & ~image->pctl_mask) | image->pctl;
+	
+	/*Setting a DRxR bit clears it in the other two, zeros are ignored*/
+	GPIOx->DR2R = image->dr2r;
+	GPIOx->DR4R = image->dr4r;
+	GPIOx->DR8R = image->dr8r;
+	
+	GPIOx->ODR = (GPIOx->ODR & keep) | image->odr;
+	GPIOx->PUR = (GPIOx->PUR & keep) | image->pur;
+	GPIOx->PDR = (GPIOx->PDR & keep) | image->pdr;
+	GPIOx->DEN = (GPIOx->DEN & keep) | image->den;
+	
+	/*Sense changes can latch a stale edge, clear it before unmasking*/
+	GPIOx->IS = (GPIOx->IS & keep) | image->is;
+	GPIOx->IBE = (GPIOx->IBE & keep) | image->ibe;
+	GPIOx->IEV = (GPIOx->IEV & keep) | image->iev;
+	GPIOx->ICR = image->im;
+	GPIOx->IM = (GPIOx->IM & keep) | image->im;
+	
+	/*Any other value locks GPIOCR again*/
+	GPIOx->LOCK = 0;
+}
+
+/**
+	* @brief  Initializes a whole board from a const pin table
+	* @param  *pins : pin table
+	* @param  count : number of entries in the table
+	* @retval None
+	*/
+void hal_gpio_init_table(const gpio_board_pin_t *pins, uint32_t count){
+	
+	gpio_port_image_t images[GPIO_NUM_PORTS] = {0};
+	uint32_t index;
+	
+	for(index = 0; index < count; index++){
+		hal_gpio_merge_pin(&images[pins[index].port], &pins[index]);
+	}
+	
+	for(index = 0; index < GPIO_NUM_PORTS; index++){
+		
+		if(!images[index].used)
+			continue;
+		
+		hal_gpio_enable_clock((gpio_port_number)index);
+		hal_gpio_write_port_image(hal_gpio_get_port((gpio_port_number)index), &images[index]);
+		
+		if(images[index].im)
+			NVIC_EnableIRQ(gpio_port_irq[index]);
+	}
+}
+
 
 /**
 	* @brief  Read a value from a  given pin number 
@@ -26,7 +240,7 @@ void hal_gpio_init(GPIOA_Type *GPIOx, gpio_pin_config_t *gpio_pin_config){
 	*/
 uint8_t hal_gpio_read_pin(GPIOA_Type *GPIOx, uint16_t pin_no){
 	
-	return ((GPIOx->DATA >> pin_no) & 0x00000001);
+	return (GPIO_DATA_MASKED(GPIOx, 1 << pin_no) >> pin_no);
 }
 
 /**
@@ -37,12 +251,65 @@ uint8_t hal_gpio_read_pin(GPIOA_Type *GPIOx, uint16_t pin_no){
 	* @retval None
 	*/
 void hal_gpio_write_to_pin(GPIOA_Type *GPIOx, uint16_t pin_no, uint8_t value){
-	if(value){
-		GPIOx->DATA |= (1 << pin_no);
-	}
-	else{
-		GPIOx->DATA &= ~(1 << pin_no);
-	}
+	
+	/*Masked store: only this pin is affected, no read-modify-write*/
+	GPIO_DATA_MASKED(GPIOx, 1 << pin_no) = value ? GPIO_PIN_ALL : 0;
+}
+
+/**
+	* @brief  Drives the pins in pin_mask high with a single store, ISR safe
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_mask : GPIO_PIN_x values or'ed together
+	* @retval None
+	*/
+void hal_gpio_set_pins(GPIOA_Type *GPIOx, uint8_t pin_mask){
+	GPIO_DATA_MASKED(GPIOx, pin_mask) = GPIO_PIN_ALL;
+}
+
+/**
+	* @brief  Drives the pins in pin_mask low with a single store, ISR safe
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_mask : GPIO_PIN_x values or'ed together
+	* @retval None
+	*/
+void hal_gpio_clear_pins(GPIOA_Type *GPIOx, uint8_t pin_mask){
+	GPIO_DATA_MASKED(GPIOx, pin_mask) = 0;
+}
+
+/**
+	* @brief  Writes value to the pins in pin_mask only, with a single store, ISR safe
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_mask : GPIO_PIN_x values or'ed together
+	* @param  value : new pin levels, bits outside pin_mask are ignored
+	* @retval None
+	*/
+void hal_gpio_write_pins(GPIOA_Type *GPIOx, uint8_t pin_mask, uint8_t value){
+	GPIO_DATA_MASKED(GPIOx, pin_mask) = value;
+}
+
+/**
+	* @brief  Reads the pins in pin_mask, all other bits read as 0
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_mask : GPIO_PIN_x values or'ed together
+	* @retval uint8_t: pin levels
+	*/
+uint8_t hal_gpio_read_pins(GPIOA_Type *GPIOx, uint8_t pin_mask){
+	return (uint8_t)GPIO_DATA_MASKED(GPIOx, pin_mask);
+}
+
+/**
+	* @brief  Inverts the pins in pin_mask
+	* Other pins of the port are never touched, but concurrent writers of the
+	* same pins must not preempt the read and the write.
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_mask : GPIO_PIN_x values or'ed together
+	* @retval None
+	*/
+void hal_gpio_toggle_pins(GPIOA_Type *GPIOx, uint8_t pin_mask){
+	
+	volatile uint32_t *data = &GPIO_DATA_MASKED(GPIOx, pin_mask);
+	
+	*data = ~(*data);
 }
 
 /**
@@ -76,10 +343,7 @@ void hal_gpio_write_port(GPIOA_Type *GPIOx, uint8_t value){
 	* @retval None
 	*/
 void hal_gpio_set_pin_mode(GPIOA_Type *GPIOx, uint16_t pin_no, uint8_t pin_mode){
-	if(pin_mode)
-		GPIOx->DIR |= (pin_mode << pin_no);
-	else
-		GPIOx->DIR &= ~(pin_mode << pin_no);
+	bitband_write(&GPIOx->DIR, pin_no, pin_mode);
 }
 
 
@@ -91,7 +355,34 @@ void hal_gpio_set_pin_mode(GPIOA_Type *GPIOx, uint16_t pin_no, uint8_t pin_mode)
 	*/
 void hal_gpio_set_alt_function(GPIOA_Type *GPIOx, uint16_t pin_no){
 	
-	GPIOx->AFSEL |= (1 << pin_no);
+	bitband_set(&GPIOx->AFSEL, pin_no);
+}
+
+/**
+	* @brief  Allows AFSEL, PUR, PDR and DEN of a pin to be changed (GPIOCR)
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_no : GPIO pin number 
+	* @retval None
+	*/
+void hal_gpio_enable_changes_on_pin(GPIOA_Type *GPIOx, uint16_t pin_no){
+	
+	GPIOx->LOCK = GPIO_LOCK_KEY;
+	bitband_set(&GPIOx->CR, pin_no);
+	GPIOx->LOCK = 0;
+}
+
+/**
+	* @brief  Selects the peripheral signal of a pin in GPIOPCTL
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_no : GPIO pin number 
+	* @param  mux_value : PMCx encoding of the signal (see the pin mux table), 0 = GPIO
+	* @retval None
+	*/
+void hal_gpio_configure_mux_control(GPIOA_Type *GPIOx, uint16_t pin_no, uint8_t mux_value){
+	
+	uint32_t shift = pin_no * 4;
+	
+	GPIOx->PCTL = (GPIOx->PCTL & ~(0x0FUL << shift)) | ((uint32_t)(mux_value & 0x0F) << shift);
 }
 
 /**
@@ -103,14 +394,15 @@ void hal_gpio_set_alt_function(GPIOA_Type *GPIOx, uint16_t pin_no){
 	*/	
 void hal_gpio_configure_drive_strength(GPIOA_Type *GPIOx, uint16_t pin_no, uint16_t drive_strength){
 
+	/*Setting a bit in one DRxR register clears it in the other two*/
 	if(drive_strength == GPIO_PIN_DS_2MA){
-		GPIOx->DR2R |= (1 << pin_no);
+		bitband_set(&GPIOx->DR2R, pin_no);
 	}
 	else if(drive_strength == GPIO_PIN_DS_4MA){
-		GPIOx->DR4R |= (1 << pin_no);
+		bitband_set(&GPIOx->DR4R, pin_no);
 	}
 	else{
-		GPIOx->DR4R |= (1 << pin_no);
+		bitband_set(&GPIOx->DR8R, pin_no);
 	}
 }
 
@@ -124,13 +416,13 @@ void hal_gpio_configure_drive_strength(GPIOA_Type *GPIOx, uint16_t pin_no, uint1
 void hal_gpio_configure_register(GPIOA_Type *GPIOx, uint16_t pin_no, uint16_t register_config){
 	
 	if(register_config == GPIO_PIN_PULL_UP){
-		GPIOx->PUR |= (1 << pin_no);
+		bitband_set(&GPIOx->PUR, pin_no);
 	}
 	else if(register_config == GPIO_PIN_PULL_DOWN){
-		GPIOx->PDR |= (1 << pin_no);
+		bitband_set(&GPIOx->PDR, pin_no);
 	}
 	else{
-		GPIOx->ODR |= (1 << pin_no);
+		bitband_set(&GPIOx->ODR, pin_no);
 	}
 }
 
@@ -143,7 +435,7 @@ void hal_gpio_configure_register(GPIOA_Type *GPIOx, uint16_t pin_no, uint16_t re
 	*/	
 void hal_gpio_configure_digital_functionality(GPIOA_Type *GPIOx, uint16_t pin_no, bool enable){
 	
-	GPIOx->DEN |= (1 << pin_no);
+	bitband_write(&GPIOx->DEN, pin_no, enable);
 }
 
 /**
@@ -155,7 +447,7 @@ void hal_gpio_configure_digital_functionality(GPIOA_Type *GPIOx, uint16_t pin_no
 	*/
 void hal_gpio_configure_interrupt_type(GPIOA_Type *GPIOx, uint16_t pin_no, bool interrupt_type){
 	
-		GPIOx->IS |= (interrupt_type << pin_no);
+	bitband_write(&GPIOx->IS, pin_no, interrupt_type);
 }
 
 
@@ -168,14 +460,8 @@ void hal_gpio_configure_interrupt_type(GPIOA_Type *GPIOx, uint16_t pin_no, bool
 	*/	
 void hal_gpio_configure_edge_interrupt(GPIOA_Type *GPIOx, uint16_t pin_no, gpio_edge_interrupt edge_sel){
 	
-	if(edge_sel == INT_RISING_FALLING_EDGE){
-			GPIOx->IBE |= (1 << pin_no);
-	}
-	else if(edge_sel == INT_FALLING_EDGE){
-			GPIOx->IEV &= ~(1 << pin_no);
-	}else{
-			GPIOx->IEV |= (1 << pin_no);
-	}
+	bitband_write(&GPIOx->IBE, pin_no, edge_sel == INT_RISING_FALLING_EDGE);
+	bitband_write(&GPIOx->IEV, pin_no, edge_sel == INT_RISING_EDGE);
 }
 
 /**
@@ -187,12 +473,7 @@ void hal_gpio_configure_edge_interrupt(GPIOA_Type *GPIOx, uint16_t pin_no, gpio_
 	*/
 void hal_gpio_configure_level_interrupt(GPIOA_Type *GPIOx, uint16_t pin_no, gpio_level_interrupt level_sel){
 	
-	if(level_sel == INT_HIGH_LEVEL){
-		GPIOx->IEV |= (1 << pin_no);
-	}
-	else{
-		GPIOx->IEV &= ~(1 << pin_no);
-	}
+	bitband_write(&GPIOx->IEV, pin_no, level_sel == INT_HIGH_LEVEL);
 }
 
 
@@ -205,11 +486,11 @@ void hal_gpio_configure_level_interrupt(GPIOA_Type *GPIOx, uint16_t pin_no, gpio
 	*/
 void hal_gpio_enable_interrupt(GPIOA_Type *GPIOx, uint16_t pin_no, IRQn_Type irq_no){
 		
-	/*First clear the interrupt flag before enabling it*/
-	GPIOx->ICR |= (1 << pin_no);
+	/*First clear the interrupt flag before enabling it, ICR is write-1-to-clear*/
+	GPIOx->ICR = (1 << pin_no);
 	
 	/*Mask given pin to send the generated interrupt to NVIC*/
-	GPIOx->IM |= (1 << pin_no);
+	bitband_set(&GPIOx->IM, pin_no);
 	
 	/*Enable the interrupt in NVIC*/
 	NVIC_EnableIRQ(irq_no);
@@ -222,5 +503,65 @@ void hal_gpio_enable_interrupt(GPIOA_Type *GPIOx, uint16_t pin_no, IRQn_Type irq
 	* @retval None
 	*/
 void 	hal_gpio_clear_interrupt(GPIOA_Type *GPIOx, uint16_t pin_no){
-	GPIOx->ICR |= (1 << pin_no);
+	GPIOx->ICR = (1 << pin_no);
+}
+
+/**
+	* @brief  Lets the interrupt event of a pin raise a uDMA request
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_no : GPIO pin number 
+	* @param  enable : true to route the pin to the uDMA
+	* @retval None
+	*/
+void hal_gpio_configure_dma_trigger(GPIOA_Type *GPIOx, uint16_t pin_no, bool enable){
+	bitband_write(&GPIOx->DMACTL, pin_no, enable);
+}
+
+/**
+	* @brief  Lets the interrupt event of a pin trigger the ADC
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_no : GPIO pin number 
+	* @param  enable : true to route the pin to the ADC
+	* @retval None
+	*/
+void hal_gpio_configure_adc_trigger(GPIOA_Type *GPIOx, uint16_t pin_no, bool enable){
+	bitband_write(&GPIOx->ADCCTL, pin_no, enable);
+}
+
+/**
+	* @brief  Routes a pin to the uDMA channel of its port
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number 
+	* @retval uDMA channel the pin requests on
+	*/
+uint8_t hal_gpio_route_to_udma(gpio_port_number port, uint16_t pin_no){
+	
+	uint8_t channel = gpio_port_dma_channel[port];
+	
+	hal_udma_assign_channel(channel, UDMA_ENC_GPIO);
+	hal_gpio_configure_dma_trigger(hal_gpio_get_port(port), pin_no, true);
+	
+	return channel;
+}
+
+/**
+	* @brief  Routes a pin to a sample sequencer of an ADC
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number 
+	* @param  *ADCx : ADC0 or ADC1
+	* @param  sequencer : sample sequencer 0 - 3
+	* @retval None
+	*/
+void hal_gpio_route_to_adc(gpio_port_number port, uint16_t pin_no, ADC0_Type *ADCx, uint8_t sequencer){
+	
+	uint32_t shift = sequencer * 4;
+	uint32_t active = bitband_read(&ADCx->ACTSS, sequencer);
+	
+	/*The sequencer must be disabled while its trigger source changes*/
+	bitband_clear(&ADCx->ACTSS, sequencer);
+	ADCx->EMUX = (ADCx->EMUX & ~(0x0FUL << shift)) | ((uint32_t)GPIO_ADC_EMUX_TRIGGER << shift);
+	
+	hal_gpio_configure_adc_trigger(hal_gpio_get_port(port), pin_no, true);
+	
+	bitband_write(&ADCx->ACTSS, sequencer, active);
 }
@@ -5,6 +5,11 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
 /*GPIO port address*/
 
 #define GPIO_PORT_A				GPIOA_BASE
@@ -21,6 +26,24 @@
 #define GPIO_PORT_AHB_F		GPIOF_AHB_BASE
 
 
+/*GPIO pin masks, any combination can be passed to the masked access APIs*/
+#define GPIO_PIN_0								(1 << 0)
+#define GPIO_PIN_1								(1 << 1)
+#define GPIO_PIN_2								(1 << 2)
+#define GPIO_PIN_3								(1 << 3)
+#define GPIO_PIN_4								(1 << 4)
+#define GPIO_PIN_5								(1 << 5)
+#define GPIO_PIN_6								(1 << 6)
+#define GPIO_PIN_7								(1 << 7)
+#define GPIO_PIN_ALL							(0xFF)
+
+/*The DATA register is decoded over 256 words: address bits [9:2] mask which
+ *pins a load or store touches, so a single store updates any subset of pins
+ *without a read-modify-write. With constant arguments this folds to a
+ *constant address.*/
+#define GPIO_DATA_MASKED(GPIOx, pin_mask)		(*((volatile uint32_t *)((uint32_t)(GPIOx) + ((uint32_t)(pin_mask) << 2))))
+
+
 /*GPIO pin mode*/
 #define GPIO_PIN_INPUT_MODE				0x00
 #define GPIO_PIN_OUTPUT_MODE			0x01
@@ -36,6 +59,7 @@
 #define GPIO_PIN_DS_8MA						0x08
 
 /*GPIO pin register mode*/
+#define GPIO_PIN_NO_PULL					0x00
 #define	GPIO_PIN_PULL_UP					0x01
 #define GPIO_PIN_PULL_DOWN				0x02
 #define GPIO_PIN_OPEN_DRAIN				0x03
@@ -47,6 +71,20 @@
 #define EDGE_TRIGGRED_INTERRUPT				0x00
 #define LEVEL_TRIGGRED_INTERRUPT			0x01
 
+/*GPIO pin interrupt selection for the board pin table*/
+#define GPIO_PIN_INT_NONE							0x00
+#define GPIO_PIN_INT_RISING_EDGE			0x01
+#define GPIO_PIN_INT_FALLING_EDGE			0x02
+#define GPIO_PIN_INT_BOTH_EDGES				0x03
+#define GPIO_PIN_INT_LOW_LEVEL				0x04
+#define GPIO_PIN_INT_HIGH_LEVEL				0x05
+
+/*ADCEMUX value selecting the GPIO (GPIOADCCTL) trigger for a sample sequencer*/
+#define GPIO_ADC_EMUX_TRIGGER					0x4
+
+/*Value unlocking GPIOLOCK so that GPIOCR can be changed*/
+#define GPIO_LOCK_KEY									0x4C4F434B
+
 
 /*Macros to enable clock for GPIO port*/
 #define GPIO_PORTA_CLOCK_ENABLE()			(RCGCGPIO	|= (1 << 0))
@@ -87,6 +125,10 @@ typedef enum{
 }gpio_level_interrupt;
 
 
+/*Number of GPIO ports on the TM4C123GH6PM*/
+#define GPIO_NUM_PORTS						(6)
+
+
 /*Data structure for GPIO pin initialization*/
 typedef struct{
 
@@ -103,6 +145,21 @@ typedef struct{
 }gpio_pin_config_t;
 
 
+/*Board pin descriptor, meant to live in a const table in flash*/
+typedef struct{
+
+	uint8_t		port;														/*port number of type "gpio_port_number"*/
+	uint8_t		pin;														/*pin number 0 - 7*/
+	uint8_t		mode;														/*GPIO_PIN_INPUT_MODE or GPIO_PIN_OUTPUT_MODE*/
+	uint8_t		alt_function;										/*GPIOPCTL value of the pin, 0 = plain GPIO*/
+	uint8_t		drive_strength;									/*GPIO_PIN_DS_2MA, 4MA or 8MA*/
+	uint8_t		register_config;								/*GPIO_PIN_NO_PULL, PULL_UP, PULL_DOWN or OPEN_DRAIN*/
+	uint8_t		digital;												/*GPIO_PIN_DIGITAL_ENABLE or 0*/
+	uint8_t		interrupt;											/*GPIO_PIN_INT_xxx*/
+
+}gpio_board_pin_t;
+
+
 /***********************************************/
 /*             Various APIs for GPIO           */
 /***********************************************/
@@ -110,14 +167,61 @@ typedef struct{
 
 
 
+/**
+	* @brief  Enables the clock of a port and waits until the port is ready
+	* @param  port : port number of type "gpio_port_number"
+	* @retval None
+	*/
+void hal_gpio_enable_clock(gpio_port_number port);
+
+/**
+	* @brief  Moves a port to the AHB aperture and returns its AHB base
+	* The APB aperture of the port stops responding afterwards; the port
+	* configuration itself is kept. AHB allows back to back single cycle
+	* accesses while every APB access adds bus wait states, so bit-banging
+	* and masked DATA writes toggle faster through AHB.
+	* @param  port : port number of type "gpio_port_number"
+	* @retval GPIOA_Type* : AHB base address of the port
+	*/
+GPIOA_Type *hal_gpio_enable_ahb(gpio_port_number port);
+
+/**
+	* @brief  Returns the base address a port currently answers on (AHB or APB)
+	* @param  port : port number of type "gpio_port_number"
+	* @retval GPIOA_Type* : base address of the port
+	*/
+GPIOA_Type *hal_gpio_get_port(gpio_port_number port);
+
+/**
+	* @brief  Returns the NVIC number of a port
+	* @param  port : port number of type "gpio_port_number"
+	* @retval IRQn_Type : interrupt number of the port
+	*/
+IRQn_Type hal_gpio_get_irq(gpio_port_number port);
+
 /**
 	* @brief  Initializes the gpio pin 
+	* Applies mode, digital enable, and drive strength / register configuration
+	* when they are non zero. Interrupts are configured with the dedicated APIs.
 	* @param  *GPIOx : GPIO Port Base address
 	* @param  *gpio_pin_config :Pointer to the pin conf structure sent by application 
 	* @retval None
 	*/
 void hal_gpio_init(GPIOA_Type *GPIOx, gpio_pin_config_t *gpio_pin_config);
 
+/**
+	* @brief  Initializes a whole board from a const pin table
+	* The pins are merged into one register image per port, then each port
+	* register is written once: clocks, unlock/commit, DIR, AFSEL, PCTL,
+	* DRxR, ODR, PUR, PDR, DEN, IS, IBE, IEV, ICR and finally IM. Pins that are
+	* not in the table keep their configuration. Ports with interrupt pins
+	* are enabled in the NVIC. Ports already moved to AHB are written through AHB.
+	* @param  *pins : pin table
+	* @param  count : number of entries in the table
+	* @retval None
+	*/
+void hal_gpio_init_table(const gpio_board_pin_t *pins, uint32_t count);
+
 /**
 	* @brief  Read a value from a  given pin number 
 	* @param  *GPIOx : GPIO Port Base address
@@ -127,6 +231,49 @@ void hal_gpio_init(GPIOA_Type *GPIOx, gpio_pin_config_t *gpio_pin_config);
 uint8_t hal_gpio_read_pin(GPIOA_Type *GPIOx, uint16_t pin_no);
 
 
+/**
+	* @brief  Drives the pins in pin_mask high with a single store, ISR safe
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_mask : GPIO_PIN_x values or'ed together
+	* @retval None
+	*/
+void hal_gpio_set_pins(GPIOA_Type *GPIOx, uint8_t pin_mask);
+
+/**
+	* @brief  Drives the pins in pin_mask low with a single store, ISR safe
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_mask : GPIO_PIN_x values or'ed together
+	* @retval None
+	*/
+void hal_gpio_clear_pins(GPIOA_Type *GPIOx, uint8_t pin_mask);
+
+/**
+	* @brief  Writes value to the pins in pin_mask only, with a single store, ISR safe
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_mask : GPIO_PIN_x values or'ed together
+	* @param  value : new pin levels, bits outside pin_mask are ignored
+	* @retval None
+	*/
+void hal_gpio_write_pins(GPIOA_Type *GPIOx, uint8_t pin_mask, uint8_t value);
+
+/**
+	* @brief  Reads the pins in pin_mask, all other bits read as 0
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_mask : GPIO_PIN_x values or'ed together
+	* @retval uint8_t: pin levels
+	*/
+uint8_t hal_gpio_read_pins(GPIOA_Type *GPIOx, uint8_t pin_mask);
+
+/**
+	* @brief  Inverts the pins in pin_mask
+	* Other pins of the port are never touched, but concurrent writers of the
+	* same pins must not preempt the read and the write.
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_mask : GPIO_PIN_x values or'ed together
+	* @retval None
+	*/
+void hal_gpio_toggle_pins(GPIOA_Type *GPIOx, uint8_t pin_mask);
+
 /**
 	* @brief  Read a value from a  given port
 	* @param  *GPIOx : GPIO Port Base address
@@ -169,6 +316,25 @@ void hal_gpio_set_pin_mode(GPIOA_Type *GPIOx, uint16_t pin_no, uint8_t pin_mode)
 	*/
 void hal_gpio_set_alt_function(GPIOA_Type *GPIOx, uint16_t pin_no);
 
+/**
+	* @brief  Allows AFSEL, PUR, PDR and DEN of a pin to be changed (GPIOCR)
+	* Only matters for the locked pins (PC0-3, PD7, PF0). GPIOLOCK is
+	* unlocked for the write and locked again afterwards.
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_no : GPIO pin number 
+	* @retval None
+	*/
+void hal_gpio_enable_changes_on_pin(GPIOA_Type *GPIOx, uint16_t pin_no);
+
+/**
+	* @brief  Selects the peripheral signal of a pin in GPIOPCTL
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_no : GPIO pin number 
+	* @param  mux_value : PMCx encoding of the signal (see the pin mux table), 0 = GPIO
+	* @retval None
+	*/
+void hal_gpio_configure_mux_control(GPIOA_Type *GPIOx, uint16_t pin_no, uint8_t mux_value);
+
 /**
 	* @brief  Configure the edge triggered interrupt for a given pin number   
 	* @param  pin_no : GPIO pin number 
@@ -234,4 +400,51 @@ void hal_gpio_enable_interrupt(GPIOA_Type *GPIOx, uint16_t pin_no, IRQn_Type irq
 	*/
 void 	hal_gpio_clear_interrupt(GPIOA_Type *GPIOx, uint16_t pin_no);
 
+/**
+	* @brief  Lets the interrupt event of a pin raise a uDMA request
+	* The edge / level is selected with the interrupt APIs, IM can stay
+	* masked so that no CPU interrupt is taken.
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_no : GPIO pin number 
+	* @param  enable : true to route the pin to the uDMA
+	* @retval None
+	*/
+void hal_gpio_configure_dma_trigger(GPIOA_Type *GPIOx, uint16_t pin_no, bool enable);
+
+/**
+	* @brief  Lets the interrupt event of a pin trigger the ADC
+	* The edge / level is selected with the interrupt APIs, IM can stay
+	* masked so that no CPU interrupt is taken.
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  pin_no : GPIO pin number 
+	* @param  enable : true to route the pin to the ADC
+	* @retval None
+	*/
+void hal_gpio_configure_adc_trigger(GPIOA_Type *GPIOx, uint16_t pin_no, bool enable);
+
+/**
+	* @brief  Routes a pin to the uDMA channel of its port
+	* Maps the channel to the GPIO encoding and sets the DMACTL bit of the pin.
+	* The uDMA must be initialized and the channel programmed by the caller.
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number 
+	* @retval uDMA channel the pin requests on
+	*/
+uint8_t hal_gpio_route_to_udma(gpio_port_number port, uint16_t pin_no);
+
+/**
+	* @brief  Routes a pin to a sample sequencer of an ADC
+	* Sets the ADCCTL bit of the pin and selects the GPIO trigger in ADCEMUX.
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number 
+	* @param  *ADCx : ADC0 or ADC1
+	* @param  sequencer : sample sequencer 0 - 3
+	* @retval None
+	*/
+void hal_gpio_route_to_adc(gpio_port_number port, uint16_t pin_no, ADC0_Type *ADCx, uint8_t sequencer);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -0,0 +1,325 @@
+#include "hal_gpio_bitbang.h"
+#include "cpu.h"
+#include "hw_dwt.h"
+
+
+/*Waveforms are timed against absolute deadlines on the DWT cycle counter:
+ *every edge waits until "start + n * step", so the instructions between two
+ *edges are absorbed by the wait instead of adding up over a frame.*/
+
+
+static inline void hal_gpio_bb_high(const gpio_bb_pin_t *pin){
+	*pin->data = pin->mask;
+}
+
+static inline void hal_gpio_bb_low(const gpio_bb_pin_t *pin){
+	*pin->data = 0;
+}
+
+static inline void hal_gpio_bb_write(const gpio_bb_pin_t *pin, uint32_t value){
+	*pin->data = value ? pin->mask : 0;
+}
+
+static inline uint32_t hal_gpio_bb_read(const gpio_bb_pin_t *pin){
+	return (*pin->data != 0);
+}
+
+
+/**
+	* @brief  Resolves a pin to its masked address and sets its direction
+	* @param  *pin : pin to fill
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @param  mode : GPIO_PIN_INPUT_MODE or GPIO_PIN_OUTPUT_MODE
+	* @retval None
+	*/
+void hal_gpio_bb_pin_init(gpio_bb_pin_t *pin, gpio_port_number port, uint8_t pin_no, uint8_t mode){
+
+	GPIOA_Type *GPIOx = hal_gpio_get_port(port);
+
+	pin->data = &GPIO_DATA_MASKED(GPIOx, 1 << pin_no);
+	pin->mask = (1 << pin_no);
+
+	hal_gpio_set_pin_mode(GPIOx, pin_no, mode);
+	hal_gpio_configure_digital_functionality(GPIOx, pin_no, true);
+
+	dwt_cycle_counter_init();
+}
+
+
+/***********************************************/
+/*                    SPI                      */
+/***********************************************/
+
+/**
+	* @brief  Prepares a SPI master, SCK is left at its idle level
+	* @param  *spi : SPI to fill
+	* @param  sck, mosi, miso : pins, already resolved with hal_gpio_bb_pin_init
+	* @param  mode : GPIO_BB_SPI_MODE_0 .. 3
+	* @param  clock : core clock in Hz
+	* @param  frequency : SCK frequency in Hz
+	* @retval None
+	*/
+void hal_gpio_bb_spi_init(gpio_bb_spi_t *spi, const gpio_bb_pin_t *sck, const gpio_bb_pin_t *mosi,
+													const gpio_bb_pin_t *miso, uint8_t mode, uint32_t clock, uint32_t frequency){
+
+	spi->sck = *sck;
+	spi->mosi = *mosi;
+	spi->miso = *miso;
+	spi->cpol = (mode >> 1) & 0x01;
+	spi->cpha = mode & 0x01;
+
+	/*Round the half period up so SCK never runs faster than asked*/
+	spi->half_period = (clock + (2 * frequency) - 1) / (2 * frequency);
+
+	hal_gpio_bb_write(&spi->sck, spi->cpol);
+}
+
+/**
+	* @brief  Full duplex transfer, MSB first. Chip select is left to the caller
+	* @param  *spi : SPI master
+	* @param  *tx : bytes to send, NULL sends 0xFF
+	* @param  *rx : received bytes, NULL discards them
+	* @param  len : number of bytes
+	* @retval None
+	*/
+void hal_gpio_bb_spi_transfer(gpio_bb_spi_t *spi, const uint8_t *tx, uint8_t *rx, uint32_t len){
+
+	uint32_t half = spi->half_period;
+	uint32_t leading = !spi->cpol;
+	uint32_t trailing = spi->cpol;
+	uint32_t index, bit, out, in;
+	uint32_t deadline = dwt_cycles();
+
+	for(index = 0; index < len; index++){
+
+		out = tx ? tx[index] : 0xFF;
+		in = 0;
+
+		for(bit = 0; bit < 8; bit++){
+
+			if(!spi->cpha){
+				/*Data set up half a period before the leading edge, sampled on it*/
+				hal_gpio_bb_write(&spi->mosi, out & 0x80);
+				dwt_wait_until(deadline, half);
+				deadline += half;
+				hal_gpio_bb_write(&spi->sck, leading);
+				in = (in << 1) | hal_gpio_bb_read(&spi->miso);
+				dwt_wait_until(deadline, half);
+				deadline += half;
+				hal_gpio_bb_write(&spi->sck, trailing);
+			}
+			else{
+				/*Data shifted out on the leading edge, sampled on the trailing one*/
+				hal_gpio_bb_write(&spi->sck, leading);
+				hal_gpio_bb_write(&spi->mosi, out & 0x80);
+				dwt_wait_until(deadline, half);
+				deadline += half;
+				hal_gpio_bb_write(&spi->sck, trailing);
+				in = (in << 1) | hal_gpio_bb_read(&spi->miso);
+				dwt_wait_until(deadline, half);
+				deadline += half;
+			}
+
+			out <<= 1;
+		}
+
+		if(rx)
+			rx[index] = (uint8_t)in;
+	}
+
+	/*Hold the last bit for the slave before chip select can be released*/
+	dwt_wait_until(deadline, half);
+}
+
+
+/***********************************************/
+/*                  1-Wire                     */
+/***********************************************/
+
+/**
+	* @brief  Prepares a 1-Wire master, the pin is set to open drain and released
+	* @param  *ow : 1-Wire master to fill
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number, needs an external pull-up
+	* @param  clock : core clock in Hz
+	* @retval None
+	*/
+void hal_gpio_bb_onewire_init(gpio_bb_onewire_t *ow, gpio_port_number port, uint8_t pin_no, uint32_t clock){
+
+	hal_gpio_configure_register(hal_gpio_get_port(port), pin_no, GPIO_PIN_OPEN_DRAIN);
+	hal_gpio_bb_pin_init(&ow->dq, port, pin_no, GPIO_PIN_OUTPUT_MODE);
+	hal_gpio_bb_high(&ow->dq);
+
+	ow->reset_low = GPIO_BB_NS_TO_CYCLES(clock, 480000);
+	ow->presence_sample = GPIO_BB_NS_TO_CYCLES(clock, 70000);
+	ow->reset_recovery = GPIO_BB_NS_TO_CYCLES(clock, 410000);
+	ow->slot_start = GPIO_BB_NS_TO_CYCLES(clock, 6000);
+	ow->write0_low = GPIO_BB_NS_TO_CYCLES(clock, 60000);
+	ow->read_sample = GPIO_BB_NS_TO_CYCLES(clock, 9000);
+	ow->slot = GPIO_BB_NS_TO_CYCLES(clock, 70000);
+}
+
+/**
+	* @brief  Sends a reset pulse and samples the presence pulse
+	* @param  *ow : 1-Wire master
+	* @retval true if at least one device answered
+	*/
+bool hal_gpio_bb_onewire_reset(gpio_bb_onewire_t *ow){
+
+	uint32_t primask, start;
+	bool presence;
+
+	/*An interrupt can only stretch the reset pulse, which is harmless*/
+	start = dwt_cycles();
+	hal_gpio_bb_low(&ow->dq);
+	dwt_wait_until(start, ow->reset_low);
+
+	/*Release to sample must not be stretched*/
+	primask = CPUcpsid();
+	start = dwt_cycles();
+	hal_gpio_bb_high(&ow->dq);
+	dwt_wait_until(start, ow->presence_sample);
+	presence = !hal_gpio_bb_read(&ow->dq);
+	if(!primask)
+		CPUcpsie();
+
+	dwt_wait_until(start, ow->presence_sample + ow->reset_recovery);
+
+	return presence;
+}
+
+/**
+	* @brief  Writes or reads one time slot
+	* @param  *ow : 1-Wire master
+	* @param  bit : 1 writes a 1 (and reads), 0 writes a 0
+	* @retval level sampled in the slot
+	*/
+static uint32_t hal_gpio_bb_onewire_slot(gpio_bb_onewire_t *ow, uint32_t bit){
+
+	uint32_t primask, start, level;
+
+	primask = CPUcpsid();
+
+	start = dwt_cycles();
+	hal_gpio_bb_low(&ow->dq);
+
+	if(bit){
+		dwt_wait_until(start, ow->slot_start);
+		hal_gpio_bb_high(&ow->dq);
+		dwt_wait_until(start, ow->read_sample);
+		level = hal_gpio_bb_read(&ow->dq);
+	}
+	else{
+		dwt_wait_until(start, ow->write0_low);
+		hal_gpio_bb_high(&ow->dq);
+		level = 0;
+	}
+
+	if(!primask)
+		CPUcpsie();
+
+	/*Recovery may be longer than asked, never shorter*/
+	dwt_wait_until(start, ow->slot);
+
+	return level;
+}
+
+/**
+	* @brief  Writes one byte, LSB first
+	* @param  *ow : 1-Wire master
+	* @param  data : byte to write
+	* @retval None
+	*/
+void hal_gpio_bb_onewire_write(gpio_bb_onewire_t *ow, uint8_t data){
+
+	uint32_t bit;
+
+	for(bit = 0; bit < 8; bit++){
+		hal_gpio_bb_onewire_slot(ow, data & 0x01);
+		data >>= 1;
+	}
+}
+
+/**
+	* @brief  Reads one byte, LSB first
+	* @param  *ow : 1-Wire master
+	* @retval byte read
+	*/
+uint8_t hal_gpio_bb_onewire_read(gpio_bb_onewire_t *ow){
+
+	uint32_t bit;
+	uint8_t data = 0;
+
+	for(bit = 0; bit < 8; bit++){
+		data >>= 1;
+		if(hal_gpio_bb_onewire_slot(ow, 1))
+			data |= 0x80;
+	}
+
+	return data;
+}
+
+
+/***********************************************/
+/*                  WS2812                     */
+/***********************************************/
+
+/**
+	* @brief  Prepares a WS2812 strip output, the line is driven low
+	* @param  *strip : strip to fill
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @param  clock : core clock in Hz
+	* @retval false if the core clock is too slow for the bit timing
+	*/
+bool hal_gpio_bb_ws2812_init(gpio_bb_ws2812_t *strip, gpio_port_number port, uint8_t pin_no, uint32_t clock){
+
+	hal_gpio_bb_pin_init(&strip->din, port, pin_no, GPIO_PIN_OUTPUT_MODE);
+	hal_gpio_bb_low(&strip->din);
+
+	strip->t0h = GPIO_BB_NS_TO_CYCLES(clock, GPIO_BB_WS2812_T0H_NS);
+	strip->t1h = GPIO_BB_NS_TO_CYCLES(clock, GPIO_BB_WS2812_T1H_NS);
+	strip->bit = GPIO_BB_NS_TO_CYCLES(clock, GPIO_BB_WS2812_BIT_NS);
+	strip->reset = GPIO_BB_NS_TO_CYCLES(clock, GPIO_BB_WS2812_RESET_NS);
+
+	return (strip->bit >= GPIO_BB_WS2812_MIN_BIT_CYCLES);
+}
+
+/**
+	* @brief  Sends the colour bytes of a strip and latches them
+	* @param  *strip : strip
+	* @param  *grb : 3 bytes per LED in green, red, blue order
+	* @param  len : number of bytes
+	* @retval None
+	*/
+void hal_gpio_bb_ws2812_send(gpio_bb_ws2812_t *strip, const uint8_t *grb, uint32_t len){
+
+	uint32_t primask, start, index, bit, data;
+	volatile uint32_t *din = strip->din.data;
+	uint32_t high = strip->din.mask;
+
+	/*A stretched low phase longer than ~5 us latches the strip early*/
+	primask = CPUcpsid();
+
+	start = dwt_cycles();
+
+	for(index = 0; index < len; index++){
+
+		data = grb[index];
+
+		for(bit = 0; bit < 8; bit++){
+			*din = high;
+			dwt_wait_until(start, (data & 0x80) ? strip->t1h : strip->t0h);
+			*din = 0;
+			dwt_wait_until(start, strip->bit);
+			start += strip->bit;
+			data <<= 1;
+		}
+	}
+
+	if(!primask)
+		CPUcpsie();
+
+	dwt_wait_until(start, strip->reset);
+}
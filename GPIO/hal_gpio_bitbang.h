@@ -0,0 +1,171 @@
+#ifndef HAL_GPIO_BITBANG_H
+#define HAL_GPIO_BITBANG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_gpio.h"
+
+
+/*Converts a time in ns to core cycles, rounded up*/
+#define GPIO_BB_NS_TO_CYCLES(clock, ns)			((uint32_t)((((uint64_t)(clock) * (ns)) + 999999999ULL) / 1000000000ULL))
+
+/*SPI modes, bit 1 = CPOL, bit 0 = CPHA*/
+#define GPIO_BB_SPI_MODE_0						(0)
+#define GPIO_BB_SPI_MODE_1						(1)
+#define GPIO_BB_SPI_MODE_2						(2)
+#define GPIO_BB_SPI_MODE_3						(3)
+
+/*WS2812 bit timings in ns*/
+#define GPIO_BB_WS2812_T0H_NS					(400)
+#define GPIO_BB_WS2812_T1H_NS					(800)
+#define GPIO_BB_WS2812_BIT_NS					(1250)
+#define GPIO_BB_WS2812_RESET_NS				(300000)
+
+/*Fewest cycles per WS2812 bit the polling loop can keep up with*/
+#define GPIO_BB_WS2812_MIN_BIT_CYCLES	(48)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                  Data Structures for the bit-bang engine                  */
+/*                                                                           */
+/*****************************************************************************/
+
+/*Pin resolved once to its masked GPIODATA address, an access is one store or load*/
+typedef struct{
+
+	volatile uint32_t	*data;							/*GPIODATA address unmasking only this pin*/
+	uint32_t					mask;							/*value driving the pin high*/
+
+}gpio_bb_pin_t;
+
+/*Bit-banged SPI master*/
+typedef struct{
+
+	gpio_bb_pin_t			sck;
+	gpio_bb_pin_t			mosi;
+	gpio_bb_pin_t			miso;
+	uint8_t						cpol;							/*idle level of SCK*/
+	uint8_t						cpha;							/*0 = sample on the leading edge, 1 = on the trailing edge*/
+	uint32_t					half_period;			/*cycles of each SCK phase*/
+
+}gpio_bb_spi_t;
+
+/*Dallas 1-Wire master on an open drain pin, all times in cycles*/
+typedef struct{
+
+	gpio_bb_pin_t			dq;
+	uint32_t					reset_low;				/*480 us*/
+	uint32_t					presence_sample;	/*70 us after the release*/
+	uint32_t					reset_recovery;		/*410 us*/
+	uint32_t					slot_start;				/*6 us low opening every slot*/
+	uint32_t					write0_low;				/*60 us low for a 0*/
+	uint32_t					read_sample;			/*9 us after the opening*/
+	uint32_t					slot;							/*70 us complete slot*/
+
+}gpio_bb_onewire_t;
+
+/*WS2812 LED strip, all times in cycles*/
+typedef struct{
+
+	gpio_bb_pin_t			din;
+	uint32_t					t0h;
+	uint32_t					t1h;
+	uint32_t					bit;
+	uint32_t					reset;
+
+}gpio_bb_ws2812_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs for the bit-bang engine                         */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Resolves a pin to its masked address and sets its direction
+	* The port clock must be enabled, the DWT cycle counter is started.
+	* @param  *pin : pin to fill
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @param  mode : GPIO_PIN_INPUT_MODE or GPIO_PIN_OUTPUT_MODE
+	* @retval None
+	*/
+void hal_gpio_bb_pin_init(gpio_bb_pin_t *pin, gpio_port_number port, uint8_t pin_no, uint8_t mode);
+
+/**
+	* @brief  Prepares a SPI master, SCK is left at its idle level
+	* @param  *spi : SPI to fill
+	* @param  sck, mosi, miso : pins, already resolved with hal_gpio_bb_pin_init
+	* @param  mode : GPIO_BB_SPI_MODE_0 .. 3
+	* @param  clock : core clock in Hz
+	* @param  frequency : SCK frequency in Hz
+	* @retval None
+	*/
+void hal_gpio_bb_spi_init(gpio_bb_spi_t *spi, const gpio_bb_pin_t *sck, const gpio_bb_pin_t *mosi,
+													const gpio_bb_pin_t *miso, uint8_t mode, uint32_t clock, uint32_t frequency);
+
+/**
+	* @brief  Full duplex transfer, MSB first. Chip select is left to the caller
+	* @param  *spi : SPI master
+	* @param  *tx : bytes to send, NULL sends 0xFF
+	* @param  *rx : received bytes, NULL discards them
+	* @param  len : number of bytes
+	* @retval None
+	*/
+void hal_gpio_bb_spi_transfer(gpio_bb_spi_t *spi, const uint8_t *tx, uint8_t *rx, uint32_t len);
+
+/**
+	* @brief  Prepares a 1-Wire master, the pin is set to open drain and released
+	* @param  *ow : 1-Wire master to fill
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number, needs an external pull-up
+	* @param  clock : core clock in Hz
+	* @retval None
+	*/
+void hal_gpio_bb_onewire_init(gpio_bb_onewire_t *ow, gpio_port_number port, uint8_t pin_no, uint32_t clock);
+
+/**
+	* @brief  Sends a reset pulse and samples the presence pulse
+	* @param  *ow : 1-Wire master
+	* @retval true if at least one device answered
+	*/
+bool hal_gpio_bb_onewire_reset(gpio_bb_onewire_t *ow);
+
+/**
+	* @brief  Writes one byte, LSB first
+	* @param  *ow : 1-Wire master
+	* @param  data : byte to write
+	* @retval None
+	*/
+void hal_gpio_bb_onewire_write(gpio_bb_onewire_t *ow, uint8_t data);
+
+/**
+	* @brief  Reads one byte, LSB first
+	* @param  *ow : 1-Wire master
+	* @retval byte read
+	*/
+uint8_t hal_gpio_bb_onewire_read(gpio_bb_onewire_t *ow);
+
+/**
+	* @brief  Prepares a WS2812 strip output, the line is driven low
+	* @param  *strip : strip to fill
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @param  clock : core clock in Hz
+	* @retval false if the core clock is too slow for the bit timing
+	*/
+bool hal_gpio_bb_ws2812_init(gpio_bb_ws2812_t *strip, gpio_port_number port, uint8_t pin_no, uint32_t clock);
+
+/**
+	* @brief  Sends the colour bytes of a strip and latches them
+	* Interrupts are disabled while the bits are sent, 30 us per LED.
+	* @param  *strip : strip
+	* @param  *grb : 3 bytes per LED in green, red, blue order
+	* @param  len : number of bytes
+	* @retval None
+	*/
+void hal_gpio_bb_ws2812_send(gpio_bb_ws2812_t *strip, const uint8_t *grb, uint32_t len);
+
+#endif
@@ -0,0 +1,146 @@
+#include "hal_gpio_capture.h"
+#include "cpu.h"
+#include "hw_dwt.h"
+
+
+/**
+	* @brief  Pin handler, runs from the port dispatcher for every edge
+	* The timestamp is the first thing taken so that the jitter is only the
+	* interrupt entry and the dispatcher, never the application.
+	* @param  *context : capture channel
+	* @retval None
+	*/
+static void hal_gpio_capture_edge(void *context){
+
+	uint32_t now = dwt_cycles();
+	gpio_capture_t *capture = (gpio_capture_t *)context;
+	uint32_t level = (GPIO_DATA_MASKED(capture->GPIOx, capture->pin_mask) != 0);
+	uint16_t head = capture->head;
+
+	/*A capture may start on a falling edge, intervals need a rising edge first*/
+	if(level){
+		if(capture->rise_seen)
+			capture->period = now - capture->last_rise;
+		capture->last_rise = now;
+		capture->rise_seen = true;
+	}
+	else if(capture->rise_seen){
+		capture->high_time = now - capture->last_rise;
+	}
+
+	capture->edges++;
+
+	if((uint16_t)(head - capture->tail) > capture->mask){
+		capture->overruns++;
+		return;
+	}
+
+	capture->buffer[head & capture->mask].timestamp = now;
+	capture->buffer[head & capture->mask].level = level;
+
+	/*Make the entry visible before publishing the new head*/
+	__DMB();
+	capture->head = head + 1;
+}
+
+/**
+	* @brief  Starts capturing both edges of a pin
+	* @param  *capture : capture channel, must stay valid while capturing
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @param  *buffer : ring storage for the edges
+	* @param  size : number of entries of the ring, power of two (max 32768)
+	* @retval None
+	*/
+void hal_gpio_capture_start(gpio_capture_t *capture, gpio_port_number port, uint8_t pin_no,
+														gpio_edge_t *buffer, uint16_t size){
+
+	capture->GPIOx = hal_gpio_get_port(port);
+	capture->pin_mask = (1 << pin_no);
+	capture->buffer = buffer;
+	capture->mask = size - 1;
+	capture->head = 0;
+	capture->tail = 0;
+	capture->overruns = 0;
+	capture->edges = 0;
+	capture->last_rise = 0;
+	capture->rise_seen = false;
+	capture->period = 0;
+	capture->high_time = 0;
+
+	dwt_cycle_counter_init();
+
+	hal_gpio_set_pin_mode(capture->GPIOx, pin_no, GPIO_PIN_INPUT_MODE);
+	hal_gpio_configure_digital_functionality(capture->GPIOx, pin_no, true);
+	hal_gpio_configure_interrupt_type(capture->GPIOx, pin_no, EDGE_TRIGGRED_INTERRUPT);
+	hal_gpio_configure_edge_interrupt(capture->GPIOx, pin_no, INT_RISING_FALLING_EDGE);
+
+	hal_gpio_irq_attach(port, pin_no, hal_gpio_capture_edge, capture);
+}
+
+/**
+	* @brief  Stops capturing, edges already in the ring can still be read
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @retval None
+	*/
+void hal_gpio_capture_stop(gpio_port_number port, uint8_t pin_no){
+
+	hal_gpio_irq_detach(port, pin_no);
+}
+
+/**
+	* @brief  Reads captured edges in arrival order
+	* @param  *capture : capture channel
+	* @param  *edges : destination buffer
+	* @param  max : maximum number of edges to read
+	* @retval number of edges read
+	*/
+uint32_t hal_gpio_capture_read(gpio_capture_t *capture, gpio_edge_t *edges, uint32_t max){
+
+	uint16_t head = capture->head;
+	uint16_t tail = capture->tail;
+	uint32_t count = 0;
+
+	/*Read the entries only after the head that published them*/
+	__DMB();
+
+	while((tail != head) && (count < max)){
+		edges[count++] = capture->buffer[tail & capture->mask];
+		tail++;
+	}
+
+	capture->tail = tail;
+
+	return count;
+}
+
+/**
+	* @brief  Returns the period, high time and duty cycle of the last full pulse
+	* @param  *capture : capture channel
+	* @param  *stats : filled with the statistics
+	* @retval true once a full period has been seen
+	*/
+bool hal_gpio_capture_get_stats(gpio_capture_t *capture, gpio_capture_stats_t *stats){
+
+	uint32_t primask;
+
+	/*Take period and high time from the same pulse*/
+	primask = CPUcpsid();
+
+	stats->period = capture->period;
+	stats->high_time = capture->high_time;
+	stats->edges = capture->edges;
+
+	if(!primask)
+		CPUcpsie();
+
+	if(!stats->period){
+		stats->duty_permille = 0;
+		return false;
+	}
+
+	stats->duty_permille = (uint32_t)(((uint64_t)stats->high_time * 1000) / stats->period);
+
+	return true;
+}
@@ -0,0 +1,99 @@
+#ifndef HAL_GPIO_CAPTURE_H
+#define HAL_GPIO_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_gpio.h"
+#include "hal_gpio_irq.h"
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                  Data Structures for GPIO edge capture                    */
+/*                                                                           */
+/*****************************************************************************/
+
+/*One captured edge*/
+typedef struct{
+
+	uint32_t	timestamp;							/*DWT cycle count taken on entry of the pin handler*/
+	uint32_t	level;									/*pin level after the edge, 1 = rising, 0 = falling*/
+
+}gpio_edge_t;
+
+/*Derived pulse statistics, in CPU cycles*/
+typedef struct{
+
+	uint32_t	period;									/*rising edge to rising edge*/
+	uint32_t	high_time;							/*rising edge to falling edge*/
+	uint32_t	duty_permille;					/*high_time / period in 1/1000*/
+	uint32_t	edges;									/*edges seen since the start*/
+
+}gpio_capture_stats_t;
+
+/*Capture channel of one pin*/
+typedef struct{
+
+	GPIOA_Type				*GPIOx;						/*port base address, AHB or APB*/
+	uint8_t						pin_mask;					/*1 << pin number*/
+	gpio_edge_t				*buffer;					/*ring storage, size is a power of two*/
+	uint16_t					mask;							/*ring size - 1*/
+	volatile uint16_t	head;							/*free running write index, only written by the ISR*/
+	volatile uint16_t	tail;							/*free running read index, only written by the consumer*/
+	volatile uint32_t	overruns;					/*edges dropped because the ring was full*/
+	volatile uint32_t	edges;						/*edges seen since the start*/
+	volatile uint32_t	last_rise;				/*timestamp of the last rising edge*/
+	volatile bool			rise_seen;				/*last_rise is valid, a rising edge has been captured*/
+	volatile uint32_t	period;						/*last rising to rising interval*/
+	volatile uint32_t	high_time;				/*last rising to falling interval*/
+
+}gpio_capture_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs for GPIO edge capture                           */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Starts capturing both edges of a pin
+	* Enables the DWT cycle counter, configures the pin as a both edge
+	* interrupt input and attaches the capture handler through the
+	* dispatch table. The port clock must be enabled.
+	* @param  *capture : capture channel, must stay valid while capturing
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @param  *buffer : ring storage for the edges
+	* @param  size : number of entries of the ring, power of two (max 32768)
+	* @retval None
+	*/
+void hal_gpio_capture_start(gpio_capture_t *capture, gpio_port_number port, uint8_t pin_no,
+														gpio_edge_t *buffer, uint16_t size);
+
+/**
+	* @brief  Stops capturing, edges already in the ring can still be read
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @retval None
+	*/
+void hal_gpio_capture_stop(gpio_port_number port, uint8_t pin_no);
+
+/**
+	* @brief  Reads captured edges in arrival order
+	* @param  *capture : capture channel
+	* @param  *edges : destination buffer
+	* @param  max : maximum number of edges to read
+	* @retval number of edges read
+	*/
+uint32_t hal_gpio_capture_read(gpio_capture_t *capture, gpio_edge_t *edges, uint32_t max);
+
+/**
+	* @brief  Returns the period, high time and duty cycle of the last full pulse
+	* @param  *capture : capture channel
+	* @param  *stats : filled with the statistics
+	* @retval true once a full period has been seen
+	*/
+bool hal_gpio_capture_get_stats(gpio_capture_t *capture, gpio_capture_stats_t *stats);
+
+#endif
@@ -0,0 +1,231 @@
+#include "hal_gpio_debounce.h"
+#include "hw_bitband.h"
+
+
+/*Debouncing state of one port, bit n of every mask is pin n*/
+typedef struct{
+
+	GPIOA_Type				*GPIOx;						/*port base address, NULL while the port has no switch*/
+	uint8_t						pins;							/*switches of the port*/
+	uint8_t						active_low;				/*switches that read 0 when pressed*/
+	uint8_t						state;						/*debounced state, 1 = pressed*/
+	uint8_t						cnt0;							/*vertical counter, bit 0*/
+	uint8_t						cnt1;							/*vertical counter, bit 1*/
+	uint8_t						long_sent;				/*long press already reported for this press*/
+	volatile uint32_t	sampling;					/*pins masked and handed to the tick, set in bit-band by the ISR*/
+	uint16_t					hold[GPIO_PINS_PER_PORT];	/*ticks since the last accepted change*/
+
+}gpio_debounce_port_t;
+
+
+static gpio_debounce_port_t gpio_debounce_ports[GPIO_NUM_PORTS];
+static uint16_t gpio_debounce_long_ticks;
+
+/*Event queue, filled by the tick and drained by the application*/
+static gpio_button_event_t gpio_debounce_queue[GPIO_DEBOUNCE_QUEUE_SIZE];
+static volatile uint16_t gpio_debounce_head;
+static volatile uint16_t gpio_debounce_tail;
+static volatile uint32_t gpio_debounce_overruns;
+
+
+/**
+	* @brief  Adds an event to the queue, drops it when the queue is full
+	* @param  port : port number
+	* @param  pin : GPIO pin number
+	* @param  type : type "gpio_button_event_type"
+	* @retval None
+	*/
+static void hal_gpio_debounce_push(uint8_t port, uint8_t pin, uint8_t type){
+
+	uint16_t head = gpio_debounce_head;
+	gpio_button_event_t *event;
+
+	if((uint16_t)(head - gpio_debounce_tail) >= GPIO_DEBOUNCE_QUEUE_SIZE){
+		gpio_debounce_overruns++;
+		return;
+	}
+
+	event = &gpio_debounce_queue[head & (GPIO_DEBOUNCE_QUEUE_SIZE - 1)];
+	event->port = port;
+	event->pin = pin;
+	event->type = type;
+
+	/*Make the event visible before publishing the new head*/
+	__DMB();
+	gpio_debounce_head = head + 1;
+}
+
+/**
+	* @brief  Pin handler of the first edge: masks the pin and hands it to the tick
+	* @param  *context : port * GPIO_PINS_PER_PORT + pin
+	* @retval None
+	*/
+static void hal_gpio_debounce_edge(void *context){
+
+	uint32_t index = (uint32_t)(uintptr_t)context;
+	gpio_debounce_port_t *port = &gpio_debounce_ports[index / GPIO_PINS_PER_PORT];
+	uint32_t pin = index % GPIO_PINS_PER_PORT;
+
+	/*The dispatcher already cleared ICR, further bounces only latch RIS*/
+	bitband_clear(&port->GPIOx->IM, pin);
+	bitband_set(&port->sampling, pin);
+}
+
+/**
+	* @brief  Resets the debouncing service
+	* @param  long_press_ticks : ticks a switch must stay pressed for a long press event, 0 = never
+	* @retval None
+	*/
+void hal_gpio_debounce_init(uint16_t long_press_ticks){
+
+	uint32_t index;
+
+	for(index = 0; index < GPIO_NUM_PORTS; index++){
+		gpio_debounce_ports[index].GPIOx = 0;
+		gpio_debounce_ports[index].pins = 0;
+		gpio_debounce_ports[index].sampling = 0;
+	}
+
+	gpio_debounce_long_ticks = long_press_ticks;
+	gpio_debounce_head = 0;
+	gpio_debounce_tail = 0;
+	gpio_debounce_overruns = 0;
+}
+
+/**
+	* @brief  Puts a switch under the debouncing service
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @param  active_low : true when the switch pulls the pin to ground
+	* @retval None
+	*/
+void hal_gpio_debounce_add(gpio_port_number port, uint8_t pin_no, bool active_low){
+
+	gpio_debounce_port_t *state = &gpio_debounce_ports[port];
+	uint8_t bit = (1 << pin_no);
+
+	state->GPIOx = hal_gpio_get_port(port);
+	state->pins |= bit;
+	state->state &= ~bit;
+	state->cnt0 &= ~bit;
+	state->cnt1 &= ~bit;
+	state->long_sent &= ~bit;
+	state->hold[pin_no] = 0;
+
+	if(active_low)
+		state->active_low |= bit;
+	else
+		state->active_low &= ~bit;
+
+	hal_gpio_set_pin_mode(state->GPIOx, pin_no, GPIO_PIN_INPUT_MODE);
+	hal_gpio_configure_digital_functionality(state->GPIOx, pin_no, true);
+	hal_gpio_configure_interrupt_type(state->GPIOx, pin_no, EDGE_TRIGGRED_INTERRUPT);
+	hal_gpio_configure_edge_interrupt(state->GPIOx, pin_no, INT_RISING_FALLING_EDGE);
+
+	hal_gpio_irq_attach(port, pin_no, hal_gpio_debounce_edge,
+											(void *)(uintptr_t)(port * GPIO_PINS_PER_PORT + pin_no));
+}
+
+/**
+	* @brief  Samples every port with switches in flight, call it periodically
+	* @param  None
+	* @retval None
+	*/
+void hal_gpio_debounce_tick(void){
+
+	gpio_debounce_port_t *state;
+	uint32_t port, pin, pending;
+	uint8_t sampling, sample, delta, toggle;
+
+	for(port = 0; port < GPIO_NUM_PORTS; port++){
+
+		state = &gpio_debounce_ports[port];
+		sampling = (uint8_t)state->sampling;
+
+		if(!sampling)
+			continue;
+
+		/*One read samples every switch of the port, 1 = pressed*/
+		sample = (uint8_t)(GPIO_DATA_MASKED(state->GPIOx, state->pins) ^ state->active_low);
+
+		/*Vertical counters: each pin counts GPIO_DEBOUNCE_SAMPLES ticks of
+		 *disagreement with the debounced state before it toggles, any
+		 *agreeing sample resets its counter*/
+		delta = (sample ^ state->state) & sampling;
+		state->cnt1 = (state->cnt1 ^ state->cnt0) & delta;
+		state->cnt0 = ~state->cnt0 & delta;
+		toggle = delta & ~(state->cnt0 | state->cnt1);
+		state->state ^= toggle;
+
+		pending = sampling;
+		while(pending){
+
+			pin = 31 - __CLZ(pending);
+			pending &= ~(1UL << pin);
+
+			if(toggle & (1 << pin)){
+				state->hold[pin] = 0;
+				state->long_sent &= ~(1 << pin);
+				hal_gpio_debounce_push(port, pin, (state->state & (1 << pin)) ? BUTTON_PRESS : BUTTON_RELEASE);
+				continue;
+			}
+
+			if(state->state & (1 << pin)){
+
+				/*Held down, bounces do not restart the long press timer*/
+				if(state->hold[pin] < 0xFFFF)
+					state->hold[pin]++;
+
+				if(gpio_debounce_long_ticks && (state->hold[pin] >= gpio_debounce_long_ticks) &&
+					 !(state->long_sent & (1 << pin))){
+					state->long_sent |= (1 << pin);
+					hal_gpio_debounce_push(port, pin, BUTTON_LONG_PRESS);
+				}
+				continue;
+			}
+
+			if(delta & (1 << pin)){
+				state->hold[pin] = 0;
+				continue;
+			}
+
+			/*Released and stable: drop the latched bounces and arm the edge again*/
+			if(++state->hold[pin] >= GPIO_DEBOUNCE_SAMPLES){
+				state->hold[pin] = 0;
+				state->GPIOx->ICR = (1 << pin);
+				bitband_clear(&state->sampling, pin);
+				bitband_set(&state->GPIOx->IM, pin);
+			}
+		}
+	}
+}
+
+/**
+	* @brief  Takes the oldest event from the queue
+	* @param  *event : filled with the event
+	* @retval true if an event was available
+	*/
+bool hal_gpio_debounce_get_event(gpio_button_event_t *event){
+
+	uint16_t tail = gpio_debounce_tail;
+
+	if(tail == gpio_debounce_head)
+		return false;
+
+	/*Read the entry only after the head that published it*/
+	__DMB();
+
+	*event = gpio_debounce_queue[tail & (GPIO_DEBOUNCE_QUEUE_SIZE - 1)];
+	gpio_debounce_tail = tail + 1;
+
+	return true;
+}
+
+/**
+	* @brief  Returns the number of events lost because the queue was full
+	* @param  None
+	* @retval lost events
+	*/
+uint32_t hal_gpio_debounce_get_overruns(void){
+	return gpio_debounce_overruns;
+}
@@ -0,0 +1,90 @@
+#ifndef HAL_GPIO_DEBOUNCE_H
+#define HAL_GPIO_DEBOUNCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_gpio.h"
+#include "hal_gpio_irq.h"
+
+
+/*Consecutive equal samples needed to accept a new level (vertical counter of 2 bits)*/
+#define GPIO_DEBOUNCE_SAMPLES					(4)
+
+/*Depth of the event queue, power of two*/
+#define GPIO_DEBOUNCE_QUEUE_SIZE			(16)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                  Data Structures for switch debouncing                    */
+/*                                                                           */
+/*****************************************************************************/
+
+/*enum for the debounced switch events*/
+typedef enum{
+
+	BUTTON_PRESS,
+	BUTTON_RELEASE,
+	BUTTON_LONG_PRESS
+}gpio_button_event_type;
+
+/*One debounced event*/
+typedef struct{
+
+	uint8_t		port;											/*port number of type "gpio_port_number"*/
+	uint8_t		pin;											/*GPIO pin number*/
+	uint8_t		type;											/*type "gpio_button_event_type"*/
+
+}gpio_button_event_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs for switch debouncing                           */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Resets the debouncing service
+	* @param  long_press_ticks : ticks a switch must stay pressed for a long press event, 0 = never
+	* @retval None
+	*/
+void hal_gpio_debounce_init(uint16_t long_press_ticks);
+
+/**
+	* @brief  Puts a switch under the debouncing service
+	* The pin is configured as a digital input with a both edge interrupt.
+	* The first edge masks the pin and hands it to the periodic tick, which
+	* unmasks it again once the switch is released and stable, so a press
+	* costs one interrupt whatever the bounce. The port clock must be enabled.
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @param  active_low : true when the switch pulls the pin to ground
+	* @retval None
+	*/
+void hal_gpio_debounce_add(gpio_port_number port, uint8_t pin_no, bool active_low);
+
+/**
+	* @brief  Samples every port with switches in flight, call it periodically
+	* Every 1 - 10 ms, e.g. from SysTick_Handler. All pins of a port are
+	* debounced at once with vertical counters.
+	* @param  None
+	* @retval None
+	*/
+void hal_gpio_debounce_tick(void);
+
+/**
+	* @brief  Takes the oldest event from the queue
+	* @param  *event : filled with the event
+	* @retval true if an event was available
+	*/
+bool hal_gpio_debounce_get_event(gpio_button_event_t *event);
+
+/**
+	* @brief  Returns the number of events lost because the queue was full
+	* @param  None
+	* @retval lost events
+	*/
+uint32_t hal_gpio_debounce_get_overruns(void);
+
+#endif
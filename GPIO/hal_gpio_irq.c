@@ -0,0 +1,91 @@
+#include "hal_gpio_irq.h"
+#include "interrupt.h"
+#include "hw_bitband.h"
+
+
+/*Flat dispatch table, entry = port * GPIO_PINS_PER_PORT + pin*/
+static gpio_pin_handler_t gpio_pin_handlers[GPIO_NUM_PORTS * GPIO_PINS_PER_PORT];
+
+/*Base address the dispatcher uses for each port, latched on attach so that
+ *the ISR does not look up the AHB / APB aperture on every interrupt*/
+static GPIOA_Type *gpio_irq_ports[GPIO_NUM_PORTS];
+
+
+static void hal_gpio_irq_port_a(void){ hal_gpio_irq_dispatch(port_a); }
+static void hal_gpio_irq_port_b(void){ hal_gpio_irq_dispatch(port_b); }
+static void hal_gpio_irq_port_c(void){ hal_gpio_irq_dispatch(port_c); }
+static void hal_gpio_irq_port_d(void){ hal_gpio_irq_dispatch(port_d); }
+static void hal_gpio_irq_port_e(void){ hal_gpio_irq_dispatch(port_e); }
+static void hal_gpio_irq_port_f(void){ hal_gpio_irq_dispatch(port_f); }
+
+static void (* const gpio_irq_vectors[GPIO_NUM_PORTS])(void) = {
+	hal_gpio_irq_port_a, hal_gpio_irq_port_b, hal_gpio_irq_port_c,
+	hal_gpio_irq_port_d, hal_gpio_irq_port_e, hal_gpio_irq_port_f
+};
+
+
+/**
+	* @brief  Attaches a handler to one pin and enables its interrupt
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @param  callback : function called when the pin interrupt fires
+	* @param  context : argument given to the callback
+	* @retval None
+	*/
+void hal_gpio_irq_attach(gpio_port_number port, uint8_t pin_no, gpio_pin_callback_t callback, void *context){
+
+	gpio_pin_handler_t *handler = &gpio_pin_handlers[port * GPIO_PINS_PER_PORT + pin_no];
+
+	/*The entry must be valid before the pin is unmasked*/
+	handler->context = context;
+	handler->callback = callback;
+
+	gpio_irq_ports[port] = hal_gpio_get_port(port);
+
+	/*Vector number is the IRQ number plus the 16 core exceptions*/
+	IntRegister((uint32_t)hal_gpio_get_irq(port) + 16, gpio_irq_vectors[port]);
+
+	hal_gpio_enable_interrupt(gpio_irq_ports[port], pin_no, hal_gpio_get_irq(port));
+}
+
+/**
+	* @brief  Masks the interrupt of one pin and removes its handler
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @retval None
+	*/
+void hal_gpio_irq_detach(gpio_port_number port, uint8_t pin_no){
+
+	GPIOA_Type *GPIOx = hal_gpio_get_port(port);
+
+	bitband_clear(&GPIOx->IM, pin_no);
+	GPIOx->ICR = (1 << pin_no);
+
+	gpio_pin_handlers[port * GPIO_PINS_PER_PORT + pin_no].callback = 0;
+}
+
+/**
+	* @brief  Services every pending pin of a port
+	* @param  port : port number of type "gpio_port_number"
+	* @retval None
+	*/
+void hal_gpio_irq_dispatch(gpio_port_number port){
+
+	GPIOA_Type *GPIOx = gpio_irq_ports[port];
+	gpio_pin_handler_t *handlers = &gpio_pin_handlers[port * GPIO_PINS_PER_PORT];
+	uint32_t status = GPIOx->MIS;
+	uint32_t pin;
+
+	/*One write clears every pin serviced by this pass*/
+	GPIOx->ICR = status;
+
+	while(status){
+
+		/*Highest pending pin, CLZ is a single instruction on the M4*/
+		pin = 31 - __CLZ(status);
+		status &= ~(1UL << pin);
+
+		if(handlers[pin].callback)
+			handlers[pin].callback(handlers[pin].context);
+	}
+}
@@ -0,0 +1,66 @@
+#ifndef HAL_GPIO_IRQ_H
+#define HAL_GPIO_IRQ_H
+
+#include <stdint.h>
+#include "hal_gpio.h"
+
+
+/*Number of pins of a port, one dispatch entry each*/
+#define GPIO_PINS_PER_PORT						(8)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                  Data Structures for GPIO interrupt dispatch              */
+/*                                                                           */
+/*****************************************************************************/
+
+/*Callback of one pin, runs in the port interrupt context*/
+typedef void (*gpio_pin_callback_t)(void *context);
+
+/*Entry of the dispatch table*/
+typedef struct{
+
+	gpio_pin_callback_t	callback;					/*NULL when the pin has no handler*/
+	void								*context;					/*passed back to the callback*/
+
+}gpio_pin_handler_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs for GPIO interrupt dispatch                     */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Attaches a handler to one pin and enables its interrupt
+	* The port vector is pointed to the dispatcher with IntRegister. The trigger
+	* (edge / level) must already be configured, e.g. by hal_gpio_init_table.
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @param  callback : function called when the pin interrupt fires
+	* @param  context : argument given to the callback
+	* @retval None
+	*/
+void hal_gpio_irq_attach(gpio_port_number port, uint8_t pin_no, gpio_pin_callback_t callback, void *context);
+
+/**
+	* @brief  Masks the interrupt of one pin and removes its handler
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @retval None
+	*/
+void hal_gpio_irq_detach(gpio_port_number port, uint8_t pin_no);
+
+/**
+	* @brief  Services every pending pin of a port
+	* MIS is read once and all its bits are cleared with one ICR write before
+	* the callbacks run, highest pin first, so an edge arriving during a
+	* callback re-pends the port instead of being lost.
+	* @param  port : port number of type "gpio_port_number"
+	* @retval None
+	*/
+void hal_gpio_irq_dispatch(gpio_port_number port);
+
+#endif
@@ -0,0 +1,285 @@
+#include "hal_gpio_parallel.h"
+#include "hw_dwt.h"
+
+
+/**
+	* @brief  Configures a whole port as bus data lines, driven
+	* @param  port : port number of type "gpio_port_number"
+	* @retval GPIOA_Type* : base address of the port
+	*/
+static GPIOA_Type *hal_gpio_parallel_data_port(uint8_t port){
+
+	GPIOA_Type *GPIOx;
+
+	hal_gpio_enable_clock((gpio_port_number)port);
+	GPIOx = hal_gpio_get_port((gpio_port_number)port);
+
+	GPIOx->AFSEL &= ~GPIO_PIN_ALL;
+	GPIOx->DIR |= GPIO_PIN_ALL;
+	GPIOx->DEN |= GPIO_PIN_ALL;
+
+	return GPIOx;
+}
+
+/**
+	* @brief  Configures a control line as an output at a given idle level
+	* @param  *pin : pin to fill
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_no : GPIO pin number
+	* @param  idle : level of the line while the bus is idle
+	* @retval None
+	*/
+static void hal_gpio_parallel_control_pin(gpio_bb_pin_t *pin, uint8_t port, uint8_t pin_no, uint32_t idle){
+
+	hal_gpio_enable_clock((gpio_port_number)port);
+	hal_gpio_bb_pin_init(pin, (gpio_port_number)port, pin_no, GPIO_PIN_OUTPUT_MODE);
+
+	*pin->data = idle ? pin->mask : 0;
+}
+
+/**
+	* @brief  One strobe pulse, assert then release
+	* @param  *bus : bus handle
+	* @param  *levels : strobe[] or read_strobe[] of the bus
+	* @param  *strobe : masked address of the strobe pin
+	* @retval None
+	*/
+static inline void hal_gpio_parallel_pulse(gpio_parallel_bus_t *bus, const uint32_t *levels,
+																					 volatile uint32_t *strobe){
+	*strobe = levels[0];
+	if(bus->strobe_cycles)
+		dwt_wait_until(dwt_cycles(), bus->strobe_cycles);
+	*strobe = levels[1];
+}
+
+
+/**
+	* @brief  Clocks the ports and sets the bus idle in write direction
+	* @param  *bus : bus handle to fill
+	* @param  *config : bus configuration
+	* @retval None
+	*/
+void hal_gpio_parallel_init(gpio_parallel_bus_t *bus, const gpio_parallel_config_t *config){
+
+	bus->mode = config->mode;
+	bus->strobe_cycles = config->strobe_cycles;
+	bus->dma_busy = false;
+
+	bus->port_lo = hal_gpio_parallel_data_port(config->data_port_lo);
+	bus->data_lo = &GPIO_DATA_MASKED(bus->port_lo, GPIO_PIN_ALL);
+
+	bus->port_hi = 0;
+	bus->data_hi = 0;
+	if(config->data_port_hi != GPIO_PARALLEL_NONE){
+		bus->port_hi = hal_gpio_parallel_data_port(config->data_port_hi);
+		bus->data_hi = &GPIO_DATA_MASKED(bus->port_hi, GPIO_PIN_ALL);
+	}
+
+	if(config->mode == GPIO_PARALLEL_8080){
+		/*WR# and RD# idle high*/
+		hal_gpio_parallel_control_pin(&bus->wr, config->wr_port, config->wr_pin, 1);
+		hal_gpio_parallel_control_pin(&bus->rd, config->rd_port, config->rd_pin, 1);
+		bus->strobe[0] = 0;
+		bus->strobe[1] = bus->wr.mask;
+		bus->read_strobe[0] = 0;
+		bus->read_strobe[1] = bus->rd.mask;
+	}
+	else{
+		/*E idles low, R/W idles in write*/
+		hal_gpio_parallel_control_pin(&bus->wr, config->wr_port, config->wr_pin, 0);
+		hal_gpio_parallel_control_pin(&bus->rd, config->rd_port, config->rd_pin, 0);
+		bus->strobe[0] = bus->wr.mask;
+		bus->strobe[1] = 0;
+		bus->read_strobe[0] = bus->wr.mask;
+		bus->read_strobe[1] = 0;
+	}
+
+	bus->dc.data = 0;
+	if(config->dc_port != GPIO_PARALLEL_NONE)
+		hal_gpio_parallel_control_pin(&bus->dc, config->dc_port, config->dc_pin, 1);
+
+	dwt_cycle_counter_init();
+}
+
+/**
+	* @brief  Drives the command / data select line
+	* @param  *bus : bus handle
+	* @param  data : true for data, false for command
+	* @retval None
+	*/
+void hal_gpio_parallel_select(gpio_parallel_bus_t *bus, bool data){
+
+	if(bus->dc.data)
+		*bus->dc.data = data ? bus->dc.mask : 0;
+}
+
+/**
+	* @brief  Writes one word: data stores then one strobe pulse
+	* @param  *bus : bus handle
+	* @param  value : word, only bits 7:0 on an 8 bit bus
+	* @retval None
+	*/
+void hal_gpio_parallel_write(gpio_parallel_bus_t *bus, uint16_t value){
+
+	*bus->data_lo = value;
+	if(bus->data_hi)
+		*bus->data_hi = (value >> 8);
+
+	hal_gpio_parallel_pulse(bus, bus->strobe, bus->wr.data);
+}
+
+/**
+	* @brief  Writes a block of words back to back
+	* @param  *bus : bus handle
+	* @param  *data : uint8_t words on an 8 bit bus, uint16_t words on a 16 bit bus
+	* @param  len : number of words
+	* @retval None
+	*/
+void hal_gpio_parallel_write_burst(gpio_parallel_bus_t *bus, const void *data, uint32_t len){
+
+	volatile uint32_t *data_lo = bus->data_lo;
+	volatile uint32_t *data_hi = bus->data_hi;
+	volatile uint32_t *strobe = bus->wr.data;
+	uint32_t index;
+
+	/*Addresses and strobe levels stay in registers: two or three stores per word*/
+	if(!data_hi){
+		const uint8_t *bytes = (const uint8_t *)data;
+		for(index = 0; index < len; index++){
+			*data_lo = bytes[index];
+			hal_gpio_parallel_pulse(bus, bus->strobe, strobe);
+		}
+	}
+	else{
+		const uint16_t *words = (const uint16_t *)data;
+		for(index = 0; index < len; index++){
+			*data_lo = words[index];
+			*data_hi = (words[index] >> 8);
+			hal_gpio_parallel_pulse(bus, bus->strobe, strobe);
+		}
+	}
+}
+
+/**
+	* @brief  Reads a block of words, the bus is turned around once per block
+	* @param  *bus : bus handle
+	* @param  *data : uint8_t words on an 8 bit bus, uint16_t words on a 16 bit bus
+	* @param  len : number of words
+	* @retval None
+	*/
+void hal_gpio_parallel_read_burst(gpio_parallel_bus_t *bus, void *data, uint32_t len){
+
+	volatile uint32_t *strobe;
+	const uint32_t *levels = bus->read_strobe;
+	uint32_t index, value;
+
+	/*Release the data lines before the device drives them*/
+	bus->port_lo->DIR &= ~GPIO_PIN_ALL;
+	if(bus->port_hi)
+		bus->port_hi->DIR &= ~GPIO_PIN_ALL;
+
+	if(bus->mode == GPIO_PARALLEL_8080){
+		strobe = bus->rd.data;
+	}
+	else{
+		*bus->rd.data = bus->rd.mask;
+		strobe = bus->wr.data;
+	}
+
+	for(index = 0; index < len; index++){
+
+		/*Data is sampled while the strobe is asserted*/
+		*strobe = levels[0];
+		if(bus->strobe_cycles)
+			dwt_wait_until(dwt_cycles(), bus->strobe_cycles);
+
+		value = *bus->data_lo;
+		if(bus->data_hi)
+			value |= (*bus->data_hi << 8);
+
+		*strobe = levels[1];
+
+		if(bus->data_hi)
+			((uint16_t *)data)[index] = (uint16_t)value;
+		else
+			((uint8_t *)data)[index] = (uint8_t)value;
+	}
+
+	/*Back to the idle write direction*/
+	if(bus->mode == GPIO_PARALLEL_6800)
+		*bus->rd.data = 0;
+
+	bus->port_lo->DIR |= GPIO_PIN_ALL;
+	if(bus->port_hi)
+		bus->port_hi->DIR |= GPIO_PIN_ALL;
+}
+
+/**
+	* @brief  Starts a block write fed by the uDMA software channel
+	* @param  *bus : bus handle
+	* @param  *data : uint8_t words on an 8 bit bus, uint16_t words on a 16 bit bus
+	* @param  len : number of words
+	* @param  *tasks : task list storage, word aligned, valid until the transfer ends
+	* @param  task_count : entries of "tasks", needs GPIO_PARALLEL_DMA_TASKS_8 or 16 per word (max 256)
+	* @retval false if "tasks" is too small or the software channel still runs a block of any bus
+	*/
+bool hal_gpio_parallel_dma_write(gpio_parallel_bus_t *bus, const void *data, uint32_t len,
+																 udma_control_t *tasks, uint16_t task_count){
+
+	uint32_t per_word = bus->data_hi ? GPIO_PARALLEL_DMA_TASKS_16 : GPIO_PARALLEL_DMA_TASKS_8;
+	uint32_t needed = len * per_word;
+	uint32_t byte_flags = UDMA_CONTROL_FLAGS(UDMA_INC_NONE, UDMA_INC_NONE, UDMA_SIZE_8, UDMA_ARB_1);
+	uint32_t strobe_flags = UDMA_CONTROL_FLAGS(UDMA_INC_NONE, UDMA_INC_32, UDMA_SIZE_32, UDMA_ARB_2);
+	const uint8_t *bytes = (const uint8_t *)data;
+	udma_control_t *task = tasks;
+	uint32_t index;
+
+	if(!len || (needed > task_count) || (needed > 256))
+		return false;
+
+	/*Channel 30 and its control structures are shared by every bus, the
+	 *block in flight must not be reprogrammed under it whoever started it*/
+	if(hal_udma_is_channel_enabled(UDMA_CH30_SW))
+		return false;
+
+	/*Every task but the last one hands over to the next, the last one is AUTO*/
+	for(index = 0; index < len; index++){
+
+		hal_udma_build_transfer(task++, byte_flags, UDMA_MODE_ALT_MEM_SCATTER_GATHER,
+														(volatile void *)&bytes[bus->data_hi ? (index * 2) : index], bus->data_lo, 1);
+
+		if(bus->data_hi)
+			hal_udma_build_transfer(task++, byte_flags, UDMA_MODE_ALT_MEM_SCATTER_GATHER,
+															(volatile void *)&bytes[index * 2 + 1], bus->data_hi, 1);
+
+		/*Assert and release levels stored back to back to the strobe pin*/
+		hal_udma_build_transfer(task++, strobe_flags,
+														(index == len - 1) ? UDMA_MODE_AUTO : UDMA_MODE_ALT_MEM_SCATTER_GATHER,
+														(volatile void *)bus->strobe, bus->wr.data, 2);
+	}
+
+	hal_udma_assign_channel(UDMA_CH30_SW, UDMA_ENC_SW);
+	hal_udma_reset_channel_attributes(UDMA_CH30_SW);
+	hal_udma_set_scatter_gather(UDMA_CH30_SW, tasks, (uint16_t)needed, false);
+	bus->dma_busy = true;
+	hal_udma_enable_channel(UDMA_CH30_SW);
+	hal_udma_request_channel(UDMA_CH30_SW);
+
+	return true;
+}
+
+/**
+	* @brief  Checks whether a block started with hal_gpio_parallel_dma_write is done
+	* The software channel ends its transfer by disabling itself.
+	* @param  *bus : bus handle
+	* @retval true when the bus is free again
+	*/
+bool hal_gpio_parallel_dma_done(gpio_parallel_bus_t *bus){
+
+	if(bus->dma_busy && hal_udma_is_channel_enabled(UDMA_CH30_SW))
+		return false;
+
+	bus->dma_busy = false;
+
+	return true;
+}
@@ -0,0 +1,135 @@
+#ifndef HAL_GPIO_PARALLEL_H
+#define HAL_GPIO_PARALLEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_gpio.h"
+#include "hal_gpio_bitbang.h"
+#include "hal_udma.h"
+
+
+/*Bus protocols*/
+#define GPIO_PARALLEL_8080						(0)			/*WR# and RD# active low strobes*/
+#define GPIO_PARALLEL_6800						(1)			/*E active high strobe, R/W level*/
+
+/*Marks an unused port (8 bit bus) or an unused control pin*/
+#define GPIO_PARALLEL_NONE						(0xFF)
+
+/*uDMA tasks needed per word by hal_gpio_parallel_dma_write*/
+#define GPIO_PARALLEL_DMA_TASKS_8			(2)
+#define GPIO_PARALLEL_DMA_TASKS_16		(3)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                  Data Structures for the parallel bus                     */
+/*                                                                           */
+/*****************************************************************************/
+
+/*Parallel bus configuration, every data port uses its 8 pins*/
+typedef struct{
+
+	uint8_t		data_port_lo;						/*port carrying D7:0*/
+	uint8_t		data_port_hi;						/*port carrying D15:8, GPIO_PARALLEL_NONE for an 8 bit bus*/
+	uint8_t		mode;										/*GPIO_PARALLEL_8080 or GPIO_PARALLEL_6800*/
+	uint8_t		wr_port;								/*WR# (8080) or E (6800)*/
+	uint8_t		wr_pin;
+	uint8_t		rd_port;								/*RD# (8080) or R/W (6800)*/
+	uint8_t		rd_pin;
+	uint8_t		dc_port;								/*command / data (RS) select, GPIO_PARALLEL_NONE if unused*/
+	uint8_t		dc_pin;
+	uint32_t	strobe_cycles;					/*extra strobe width in core cycles, 0 = fastest*/
+
+}gpio_parallel_config_t;
+
+/*Parallel bus handle*/
+typedef struct{
+
+	GPIOA_Type				*port_lo;
+	GPIOA_Type				*port_hi;					/*NULL for an 8 bit bus*/
+	volatile uint32_t	*data_lo;					/*GPIODATA with D7:0 unmasked*/
+	volatile uint32_t	*data_hi;
+	gpio_bb_pin_t			wr;
+	gpio_bb_pin_t			rd;
+	gpio_bb_pin_t			dc;								/*data is NULL if unused*/
+	uint8_t						mode;
+	uint32_t					strobe_cycles;
+	uint32_t					strobe[2];				/*levels written to the strobe pin, assert then release*/
+	uint32_t					read_strobe[2];		/*same for the read strobe of the 8080 mode*/
+	volatile bool			dma_busy;					/*a block of hal_gpio_parallel_dma_write is in flight*/
+
+}gpio_parallel_bus_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs for the parallel bus                            */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Clocks the ports and sets the bus idle in write direction
+	* @param  *bus : bus handle to fill
+	* @param  *config : bus configuration
+	* @retval None
+	*/
+void hal_gpio_parallel_init(gpio_parallel_bus_t *bus, const gpio_parallel_config_t *config);
+
+/**
+	* @brief  Drives the command / data select line
+	* @param  *bus : bus handle
+	* @param  data : true for data, false for command
+	* @retval None
+	*/
+void hal_gpio_parallel_select(gpio_parallel_bus_t *bus, bool data);
+
+/**
+	* @brief  Writes one word: data stores then one strobe pulse
+	* @param  *bus : bus handle
+	* @param  value : word, only bits 7:0 on an 8 bit bus
+	* @retval None
+	*/
+void hal_gpio_parallel_write(gpio_parallel_bus_t *bus, uint16_t value);
+
+/**
+	* @brief  Writes a block of words back to back
+	* @param  *bus : bus handle
+	* @param  *data : uint8_t words on an 8 bit bus, uint16_t words on a 16 bit bus
+	* @param  len : number of words
+	* @retval None
+	*/
+void hal_gpio_parallel_write_burst(gpio_parallel_bus_t *bus, const void *data, uint32_t len);
+
+/**
+	* @brief  Reads a block of words, the bus is turned around once per block
+	* @param  *bus : bus handle
+	* @param  *data : uint8_t words on an 8 bit bus, uint16_t words on a 16 bit bus
+	* @param  len : number of words
+	* @retval None
+	*/
+void hal_gpio_parallel_read_burst(gpio_parallel_bus_t *bus, void *data, uint32_t len);
+
+/**
+	* @brief  Starts a block write fed by the uDMA software channel
+	* Each word becomes a memory scatter-gather sequence of data store(s)
+	* followed by a two item store of the strobe levels, so the CPU is free
+	* during the block. The strobe is one uDMA item wide, use it only with
+	* devices that accept the fastest strobe. The uDMA must be initialized.
+	* @param  *bus : bus handle
+	* @param  *data : uint8_t words on an 8 bit bus, uint16_t words on a 16 bit bus
+	* @param  len : number of words
+	* @param  *tasks : task list storage, word aligned, valid until the transfer ends
+	* @param  task_count : entries of "tasks", needs GPIO_PARALLEL_DMA_TASKS_8 or 16 per word (max 256)
+	* @retval false if "tasks" is too small or the software channel still runs a block of any bus
+	*/
+bool hal_gpio_parallel_dma_write(gpio_parallel_bus_t *bus, const void *data, uint32_t len,
+																 udma_control_t *tasks, uint16_t task_count);
+
+/**
+	* @brief  Checks whether a block started with hal_gpio_parallel_dma_write is done
+	* @param  *bus : bus handle
+	* @retval true when the bus is free again
+	*/
+bool hal_gpio_parallel_dma_done(gpio_parallel_bus_t *bus);
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef HAL_GPIO_PIN_HPP
+#define HAL_GPIO_PIN_HPP
+
+#include <stdint.h>
+#include "hal_gpio.h"
+
+/*Header only C++ layer over hal_gpio. A pin is a type, Pin<Port::F, 1>, so
+ *its port base and bit mask are constants: set(), clear() and write() are a
+ *single store to the masked GPIODATA address of the pin and read() a single
+ *load, with no pointer or shift left at run time.
+ *
+ *Configuration is not in the hot path and goes through the C driver.
+ *PinSet<...> groups the pins of a board and refuses at compile time a pin
+ *that appears twice.*/
+
+namespace hal{
+namespace gpio{
+
+
+/*Port of a pin, same numbering as "gpio_port_number"*/
+enum class Port : uint8_t{ A = port_a, B = port_b, C = port_c, D = port_d, E = port_e, F = port_f };
+
+/*Bus aperture the pin is accessed through, see hal_gpio_enable_ahb*/
+enum class Bus : uint8_t{ Apb, Ahb };
+
+
+/**
+	* @brief  Base address of a port on a given aperture
+	* @param  port : port of the pin
+	* @param  bus : Bus::Apb or Bus::Ahb
+	* @retval base address
+	*/
+constexpr uint32_t port_base(Port port, Bus bus){
+	return (bus == Bus::Ahb) ? (GPIOA_AHB_BASE + ((uint32_t)port << 12)) :
+				 (port == Port::A) ? GPIOA_BASE :
+				 (port == Port::B) ? GPIOB_BASE :
+				 (port == Port::C) ? GPIOC_BASE :
+				 (port == Port::D) ? GPIOD_BASE :
+				 (port == Port::E) ? GPIOE_BASE : GPIOF_BASE;
+}
+
+
+/*One pin. The port must have been clocked (and moved to AHB when Bus::Ahb
+ *is used) before any access, e.g. with hal_gpio_enable_ahb or hal_gpio_init_table*/
+template<Port P, uint8_t N, Bus B = Bus::Ahb>
+struct Pin{
+
+	static_assert(N < 8, "GPIO pin number must be 0 - 7");
+
+	static constexpr Port			port = P;
+	static constexpr uint8_t	number = N;
+	static constexpr uint8_t	mask = (uint8_t)(1u << N);
+	static constexpr uint32_t	base = port_base(P, B);
+
+	/*GPIODATA address where only this pin is unmasked (address bits 9:2)*/
+	static constexpr uint32_t	data_address = base + ((uint32_t)mask << 2);
+
+	static volatile uint32_t &data(){
+		return *reinterpret_cast<volatile uint32_t *>(data_address);
+	}
+
+	static GPIOA_Type *regs(){
+		return reinterpret_cast<GPIOA_Type *>(base);
+	}
+
+	/*Drives the pin high, a single store*/
+	static void set(){ data() = mask; }
+
+	/*Drives the pin low, a single store*/
+	static void clear(){ data() = 0; }
+
+	/*Drives the pin to "value", a single store*/
+	static void write(bool value){ data() = value ? mask : 0; }
+
+	/*Reads the pin level, a single load*/
+	static bool read(){ return data() != 0; }
+
+	/*Inverts the pin, load and store of the masked address only*/
+	static void toggle(){ data() = ~data(); }
+
+	static void make_output(uint8_t drive_strength = GPIO_PIN_DS_2MA){
+		hal_gpio_set_pin_mode(regs(), N, GPIO_PIN_OUTPUT_MODE);
+		hal_gpio_configure_drive_strength(regs(), N, drive_strength);
+		hal_gpio_configure_digital_functionality(regs(), N, true);
+	}
+
+	static void make_input(uint8_t register_config = GPIO_PIN_NO_PULL){
+		hal_gpio_set_pin_mode(regs(), N, GPIO_PIN_INPUT_MODE);
+		if(register_config)
+			hal_gpio_configure_register(regs(), N, register_config);
+		hal_gpio_configure_digital_functionality(regs(), N, true);
+	}
+};
+
+
+/*Set of pins owned by a board or a driver, e.g.
+ *		typedef PinSet<LedRed, LedBlue, Sw2> board_pins;
+ *A pin appearing twice in the set is a compile error once the set is used.*/
+template<typename... Pins>
+struct PinSet;
+
+template<>
+struct PinSet<>{
+
+	static constexpr uint8_t mask(Port){ return 0; }
+	static constexpr bool same_port(Port){ return true; }
+};
+
+template<typename First, typename... Rest>
+struct PinSet<First, Rest...>{
+
+	static_assert((PinSet<Rest...>::mask(First::port) & First::mask) == 0,
+								"GPIO pin configured twice in the same PinSet");
+
+	/*Pins of the set that belong to "port"*/
+	static constexpr uint8_t mask(Port port){
+		return (uint8_t)(((port == First::port) ? First::mask : 0) | PinSet<Rest...>::mask(port));
+	}
+
+	static constexpr bool same_port(Port port){
+		return (port == First::port) && PinSet<Rest...>::same_port(port);
+	}
+
+	static constexpr Port			port = First::port;
+	static constexpr uint8_t	port_mask = mask(First::port);
+	static constexpr uint32_t	data_address = First::base + ((uint32_t)port_mask << 2);
+
+	/*Writes all the pins of the set at once, bits follow the pin numbers.
+	 *Only for sets on a single port and aperture: one store*/
+	static void write(uint8_t value){
+		static_assert(same_port(First::port), "PinSet::write needs all pins on one port");
+		*reinterpret_cast<volatile uint32_t *>(data_address) = value;
+	}
+
+	/*Reads all the pins of the set at once, one load*/
+	static uint8_t read(){
+		static_assert(same_port(First::port), "PinSet::read needs all pins on one port");
+		return (uint8_t)*reinterpret_cast<volatile uint32_t *>(data_address);
+	}
+};
+
+
+}
+}
+
+#endif
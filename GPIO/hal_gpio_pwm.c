@@ -0,0 +1,181 @@
+#include "hal_gpio_pwm.h"
+
+
+/*The timer runs periodic with TAILD set: a new interval load only takes
+ *effect at the next timeout. The handler of the timeout that starts step n
+ *therefore writes the port value of step n and the duration of step n + 1.
+ *Each edge still carries the entry latency of its interrupt and any delay
+ *from preemption, but the timeouts stay on the timer grid and that jitter
+ *never adds up from one step or period to the next.*/
+
+
+/**
+	* @brief  Plays one step: port value now, duration of the following step
+	* @param  *pwm : engine
+	* @retval None
+	*/
+static void hal_gpio_pwm_play_step(gpio_pwm_t *pwm){
+
+	gpio_pwm_schedule_t *schedule = pwm->active;
+	gpio_pwm_schedule_t *upcoming;
+	uint8_t next = pwm->step + 1;
+
+	*pwm->data = schedule->steps[pwm->step].value;
+
+	if(next < schedule->count){
+		pwm->TIMERx->TAILR = schedule->steps[next].duration - 1;
+		pwm->step = next;
+		return;
+	}
+
+	/*Last step of the period, a new schedule can only start here*/
+	upcoming = pwm->pending ? pwm->pending : schedule;
+	pwm->TIMERx->TAILR = upcoming->steps[0].duration - 1;
+
+	pwm->active = upcoming;
+	pwm->pending = 0;
+	pwm->step = 0;
+	pwm->frames++;
+}
+
+/**
+	* @brief  Starts a PWM engine with every channel off
+	* @param  *pwm : engine to fill
+	* @param  port : port number of type "gpio_port_number"
+	* @param  *pins : pin number of each channel
+	* @param  channels : number of channels, 1 to GPIO_PWM_MAX_CHANNELS
+	* @param  timer : timer block of type "timer_number"
+	* @param  clock : timer clock in Hz
+	* @param  frequency : PWM frequency in Hz
+	* @retval None
+	*/
+void hal_gpio_pwm_init(gpio_pwm_t *pwm, gpio_port_number port, const uint8_t *pins, uint8_t channels,
+											 timer_number timer, uint32_t clock, uint32_t frequency){
+
+	GPIOA_Type *GPIOx = hal_gpio_get_port(port);
+	uint8_t mask = 0;
+	uint8_t index;
+
+	for(index = 0; index < channels; index++){
+		pwm->pins[index] = (1 << pins[index]);
+		pwm->duty[index] = 0;
+		mask |= pwm->pins[index];
+
+		hal_gpio_set_pin_mode(GPIOx, pins[index], GPIO_PIN_OUTPUT_MODE);
+		hal_gpio_configure_digital_functionality(GPIOx, pins[index], true);
+	}
+
+	pwm->channels = channels;
+	pwm->data = &GPIO_DATA_MASKED(GPIOx, mask);
+	pwm->period = clock / frequency;
+
+	/*Single step schedule: everything off for a whole period*/
+	pwm->schedules[0].steps[0].duration = pwm->period;
+	pwm->schedules[0].steps[0].value = 0;
+	pwm->schedules[0].count = 1;
+	pwm->active = &pwm->schedules[0];
+	pwm->pending = 0;
+	pwm->step = 0;
+	pwm->frames = 0;
+
+	pwm->TIMERx = hal_timer_init_periodic(timer, pwm->period, true);
+	hal_gpio_pwm_play_step(pwm);
+	hal_timer_start(pwm->TIMERx);
+}
+
+/**
+	* @brief  Sets the duty of a channel, applied by hal_gpio_pwm_update
+	* @param  *pwm : engine
+	* @param  channel : channel index
+	* @param  duty : 0 to GPIO_PWM_MAX_DUTY
+	* @retval None
+	*/
+void hal_gpio_pwm_set_duty(gpio_pwm_t *pwm, uint8_t channel, uint8_t duty){
+	pwm->duty[channel] = duty;
+}
+
+/**
+	* @brief  Sorts the channel edges into a new schedule, played from the next period
+	* @param  *pwm : engine
+	* @retval false if the previous schedule is not yet taken, retry later
+	*/
+bool hal_gpio_pwm_update(gpio_pwm_t *pwm){
+
+	gpio_pwm_schedule_t *schedule;
+	uint32_t on[GPIO_PWM_MAX_CHANNELS];
+	uint8_t order[GPIO_PWM_MAX_CHANNELS];
+	uint32_t period = pwm->period;
+	uint32_t time[GPIO_PWM_MAX_CHANNELS + 1];
+	uint8_t index, sorted, count, channel;
+
+	if(pwm->pending)
+		return false;
+
+	/*The schedule the ISR is not playing*/
+	schedule = (pwm->active == &pwm->schedules[0]) ? &pwm->schedules[1] : &pwm->schedules[0];
+
+	/*Falling edge of each channel, insertion sorted (8 channels at most)*/
+	for(index = 0; index < pwm->channels; index++){
+
+		on[index] = (uint32_t)(((uint64_t)pwm->duty[index] * period) / GPIO_PWM_MAX_DUTY);
+
+		/*Edges too close to the period boundary become fully off / on*/
+		if(on[index] < GPIO_PWM_MIN_STEP_CYCLES)
+			on[index] = 0;
+		else if(on[index] > period - GPIO_PWM_MIN_STEP_CYCLES)
+			on[index] = period;
+
+		for(sorted = index; (sorted > 0) && (on[order[sorted - 1]] > on[index]); sorted--)
+			order[sorted] = order[sorted - 1];
+		order[sorted] = index;
+	}
+
+	/*Step 0 switches on every channel with a non zero duty*/
+	schedule->steps[0].value = 0;
+	for(index = 0; index < pwm->channels; index++){
+		if(on[index])
+			schedule->steps[0].value |= pwm->pins[index];
+	}
+	time[0] = 0;
+	count = 1;
+
+	/*One step per distinct falling edge, close edges share a step*/
+	for(index = 0; index < pwm->channels; index++){
+
+		channel = order[index];
+
+		if(!on[channel] || (on[channel] == period))
+			continue;
+
+		if(on[channel] - time[count - 1] < GPIO_PWM_MIN_STEP_CYCLES){
+			schedule->steps[count - 1].value &= ~pwm->pins[channel];
+			continue;
+		}
+
+		time[count] = on[channel];
+		schedule->steps[count].value = schedule->steps[count - 1].value & ~pwm->pins[channel];
+		count++;
+	}
+
+	for(index = 0; index < count - 1; index++)
+		schedule->steps[index].duration = time[index + 1] - time[index];
+	schedule->steps[count - 1].duration = period - time[count - 1];
+	schedule->count = count;
+
+	/*Publish, the ISR takes it at the end of the current period*/
+	__DMB();
+	pwm->pending = schedule;
+
+	return true;
+}
+
+/**
+	* @brief  Timer interrupt handler, one port write per step
+	* @param  *pwm : engine
+	* @retval None
+	*/
+void hal_gpio_pwm_handle_interrupt(gpio_pwm_t *pwm){
+
+	hal_timer_clear_timeout(pwm->TIMERx);
+	hal_gpio_pwm_play_step(pwm);
+}
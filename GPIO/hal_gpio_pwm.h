@@ -0,0 +1,106 @@
+#ifndef HAL_GPIO_PWM_H
+#define HAL_GPIO_PWM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_gpio.h"
+#include "hal_timer.h"
+
+
+/*Channels of one engine, all on the same port*/
+#define GPIO_PWM_MAX_CHANNELS					(8)
+
+/*Duty cycle range, 0 = off and GPIO_PWM_MAX_DUTY = always on*/
+#define GPIO_PWM_MAX_DUTY							(255)
+
+/*Closest two edges can be, in timer cycles. Closer edges are merged, which
+ *keeps the time left to the ISR between two timeouts above this value*/
+#define GPIO_PWM_MIN_STEP_CYCLES			(400)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                  Data Structures for the software PWM                     */
+/*                                                                           */
+/*****************************************************************************/
+
+/*One step of a period: the port value and how long it is held*/
+typedef struct{
+
+	uint32_t	duration;								/*timer cycles until the next step*/
+	uint32_t	value;									/*value written to the channel pins*/
+
+}gpio_pwm_step_t;
+
+/*Sorted edges of one period*/
+typedef struct{
+
+	gpio_pwm_step_t	steps[GPIO_PWM_MAX_CHANNELS + 1];
+	uint8_t					count;
+
+}gpio_pwm_schedule_t;
+
+/*Software PWM engine*/
+typedef struct{
+
+	TIMER0_Type										*TIMERx;			/*timer pacing the steps*/
+	volatile uint32_t							*data;				/*GPIODATA with every channel pin unmasked*/
+	uint8_t												pins[GPIO_PWM_MAX_CHANNELS];	/*pin mask of each channel*/
+	uint8_t												duty[GPIO_PWM_MAX_CHANNELS];	/*duty of each channel*/
+	uint8_t												channels;			/*number of channels*/
+	uint32_t											period;				/*timer cycles per period*/
+	gpio_pwm_schedule_t						schedules[2];	/*active and shadow schedule*/
+	gpio_pwm_schedule_t * volatile	active;			/*schedule being played by the ISR*/
+	gpio_pwm_schedule_t * volatile	pending;		/*schedule to play from the next period, NULL if none*/
+	uint8_t												step;					/*step the next timeout starts*/
+	volatile uint32_t							frames;				/*periods played since the start*/
+
+}gpio_pwm_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs for the software PWM                            */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Starts a PWM engine with every channel off
+	* The port clock must be enabled. The handler of the timer must call
+	* hal_gpio_pwm_handle_interrupt.
+	* @param  *pwm : engine to fill
+	* @param  port : port number of type "gpio_port_number"
+	* @param  *pins : pin number of each channel
+	* @param  channels : number of channels, 1 to GPIO_PWM_MAX_CHANNELS
+	* @param  timer : timer block of type "timer_number"
+	* @param  clock : timer clock in Hz
+	* @param  frequency : PWM frequency in Hz
+	* @retval None
+	*/
+void hal_gpio_pwm_init(gpio_pwm_t *pwm, gpio_port_number port, const uint8_t *pins, uint8_t channels,
+											 timer_number timer, uint32_t clock, uint32_t frequency);
+
+/**
+	* @brief  Sets the duty of a channel, applied by hal_gpio_pwm_update
+	* @param  *pwm : engine
+	* @param  channel : channel index
+	* @param  duty : 0 to GPIO_PWM_MAX_DUTY
+	* @retval None
+	*/
+void hal_gpio_pwm_set_duty(gpio_pwm_t *pwm, uint8_t channel, uint8_t duty);
+
+/**
+	* @brief  Sorts the channel edges into a new schedule, played from the next period
+	* @param  *pwm : engine
+	* @retval false if the previous schedule is not yet taken, retry later
+	*/
+bool hal_gpio_pwm_update(gpio_pwm_t *pwm);
+
+/**
+	* @brief  Timer interrupt handler, one port write per step
+	* @param  *pwm : engine
+	* @retval None
+	*/
+void hal_gpio_pwm_handle_interrupt(gpio_pwm_t *pwm);
+
+#endif
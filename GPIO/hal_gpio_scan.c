@@ -0,0 +1,263 @@
+#include "hal_gpio_scan.h"
+#include "hw_dwt.h"
+
+
+/*Quarter step of an encoder indexed by (previous AB << 2) | current AB:
+ *+1 clockwise, -1 counter clockwise, 0 for no move or an invalid jump*/
+static const int8_t gpio_encoder_table[16] = {
+	 0, -1,  1,  0,
+	 1,  0,  0, -1,
+	-1,  0,  0,  1,
+	 0,  1, -1,  0
+};
+
+
+/**
+	* @brief  Adds an event to the FIFO, drops it when the FIFO is full
+	* @param  *scanner : scanner
+	* @param  timestamp : cycle count of the scan
+	* @param  type : type "gpio_scan_event_type"
+	* @param  source : key or encoder index
+	* @retval None
+	*/
+static void hal_gpio_scan_push(gpio_scanner_t *scanner, uint32_t timestamp, uint8_t type, uint8_t source){
+
+	uint16_t head = scanner->head;
+	gpio_scan_event_t *event;
+
+	if((uint16_t)(head - scanner->tail) >= GPIO_SCAN_FIFO_SIZE){
+		scanner->overruns++;
+		return;
+	}
+
+	event = &scanner->fifo[head & (GPIO_SCAN_FIFO_SIZE - 1)];
+	event->timestamp = timestamp;
+	event->type = type;
+	event->source = source;
+
+	/*Make the event visible before publishing the new head*/
+	__DMB();
+	scanner->head = head + 1;
+}
+
+/**
+	* @brief  Reads the AB state of an encoder
+	* @param  *encoder : encoder
+	* @retval A in bit 1, B in bit 0
+	*/
+static uint8_t hal_gpio_scan_encoder_state(gpio_encoder_t *encoder){
+
+	uint32_t pins = *encoder->data;
+
+	return (uint8_t)((((pins & encoder->a_mask) != 0) << 1) | ((pins & encoder->b_mask) != 0));
+}
+
+/**
+	* @brief  Resets a scanner, without keypad and encoders
+	* @param  *scanner : scanner
+	* @retval None
+	*/
+void hal_gpio_scan_init(gpio_scanner_t *scanner){
+
+	scanner->TIMERx = 0;
+	scanner->keypad.rows = 0;
+	scanner->encoder_count = 0;
+	scanner->head = 0;
+	scanner->tail = 0;
+	scanner->overruns = 0;
+
+	dwt_cycle_counter_init();
+}
+
+/**
+	* @brief  Adds the key matrix, the port clocks must be enabled
+	* @param  *scanner : scanner
+	* @param  row_port : port of the rows, type "gpio_port_number"
+	* @param  *row_pins : pin number of each row
+	* @param  rows : number of rows, 1 to GPIO_SCAN_MAX_ROWS
+	* @param  col_port : port of the columns, type "gpio_port_number"
+	* @param  col_mask : column pins as a mask (GPIO_PIN_x)
+	* @retval None
+	*/
+void hal_gpio_scan_add_keypad(gpio_scanner_t *scanner, gpio_port_number row_port, const uint8_t *row_pins,
+															uint8_t rows, gpio_port_number col_port, uint8_t col_mask){
+
+	gpio_keypad_t *keypad = &scanner->keypad;
+	GPIOA_Type *GPIOx = hal_gpio_get_port(row_port);
+	uint8_t index;
+
+	keypad->row_mask = 0;
+
+	/*Open drain rows: two keys of one column never short two driven rows*/
+	for(index = 0; index < rows; index++){
+		keypad->row_pins[index] = (1 << row_pins[index]);
+		keypad->row_mask |= keypad->row_pins[index];
+		keypad->state[index] = 0;
+		keypad->sample[index] = 0;
+
+		hal_gpio_set_pin_mode(GPIOx, row_pins[index], GPIO_PIN_OUTPUT_MODE);
+		hal_gpio_configure_register(GPIOx, row_pins[index], GPIO_PIN_OPEN_DRAIN);
+		hal_gpio_configure_digital_functionality(GPIOx, row_pins[index], true);
+	}
+
+	keypad->row_data = &GPIO_DATA_MASKED(GPIOx, keypad->row_mask);
+	*keypad->row_data = keypad->row_mask;
+
+	GPIOx = hal_gpio_get_port(col_port);
+	for(index = 0; index < 8; index++){
+		if(!(col_mask & (1 << index)))
+			continue;
+
+		hal_gpio_set_pin_mode(GPIOx, index, GPIO_PIN_INPUT_MODE);
+		hal_gpio_configure_register(GPIOx, index, GPIO_PIN_PULL_UP);
+		hal_gpio_configure_digital_functionality(GPIOx, index, true);
+	}
+
+	keypad->col_data = &GPIO_DATA_MASKED(GPIOx, col_mask);
+	keypad->col_mask = col_mask;
+	keypad->rows = rows;
+}
+
+/**
+	* @brief  Adds a quadrature encoder with pulled up inputs, the port clock must be enabled
+	* @param  *scanner : scanner
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_a : pin number of channel A
+	* @param  pin_b : pin number of channel B
+	* @param  steps_per_detent : quarter steps per event, 4 for most knobs
+	* @retval index of the encoder, used as event source
+	*/
+uint8_t hal_gpio_scan_add_encoder(gpio_scanner_t *scanner, gpio_port_number port, uint8_t pin_a,
+																	uint8_t pin_b, uint8_t steps_per_detent){
+
+	uint8_t index = scanner->encoder_count;
+	gpio_encoder_t *encoder = &scanner->encoders[index];
+	GPIOA_Type *GPIOx = hal_gpio_get_port(port);
+
+	hal_gpio_set_pin_mode(GPIOx, pin_a, GPIO_PIN_INPUT_MODE);
+	hal_gpio_configure_register(GPIOx, pin_a, GPIO_PIN_PULL_UP);
+	hal_gpio_configure_digital_functionality(GPIOx, pin_a, true);
+	hal_gpio_set_pin_mode(GPIOx, pin_b, GPIO_PIN_INPUT_MODE);
+	hal_gpio_configure_register(GPIOx, pin_b, GPIO_PIN_PULL_UP);
+	hal_gpio_configure_digital_functionality(GPIOx, pin_b, true);
+
+	encoder->a_mask = (1 << pin_a);
+	encoder->b_mask = (1 << pin_b);
+	encoder->data = &GPIO_DATA_MASKED(GPIOx, encoder->a_mask | encoder->b_mask);
+	encoder->steps_per_detent = steps_per_detent;
+	encoder->count = 0;
+	encoder->state = hal_gpio_scan_encoder_state(encoder);
+
+	scanner->encoder_count = index + 1;
+
+	return index;
+}
+
+/**
+	* @brief  Scans periodically from timer A of a block
+	* @param  *scanner : scanner
+	* @param  timer : timer block of type "timer_number"
+	* @param  clock : timer clock in Hz
+	* @param  scan_hz : scans per second, fast enough for the encoders
+	* @retval None
+	*/
+void hal_gpio_scan_start(gpio_scanner_t *scanner, timer_number timer, uint32_t clock, uint32_t scan_hz){
+
+	scanner->TIMERx = hal_timer_init_periodic(timer, clock / scan_hz, false);
+	hal_timer_start(scanner->TIMERx);
+}
+
+/**
+	* @brief  Runs one scan of the keypad and of every encoder
+	* @param  *scanner : scanner
+	* @retval None
+	*/
+void hal_gpio_scan_run(gpio_scanner_t *scanner){
+
+	gpio_keypad_t *keypad = &scanner->keypad;
+	gpio_encoder_t *encoder;
+	uint32_t now = dwt_cycles();
+	uint32_t row, col, start;
+	uint8_t sample, changed;
+	uint8_t state;
+
+	for(row = 0; row < keypad->rows; row++){
+
+		/*One store pulls this row low and releases every other row*/
+		*keypad->row_data = keypad->row_mask & ~keypad->row_pins[row];
+		start = dwt_cycles();
+		dwt_wait_until(start, GPIO_SCAN_ROW_SETTLE_CYCLES);
+
+		/*One load reads every column, pressed keys read low*/
+		sample = (uint8_t)~*keypad->col_data & keypad->col_mask;
+
+		/*Accept a change once two scans agree on it*/
+		changed = (keypad->state[row] ^ sample) & ~(keypad->sample[row] ^ sample);
+		keypad->sample[row] = sample;
+		keypad->state[row] ^= changed;
+
+		while(changed){
+			col = 31 - __CLZ(changed);
+			changed &= ~(1 << col);
+			hal_gpio_scan_push(scanner, now, (keypad->state[row] & (1 << col)) ? SCAN_KEY_DOWN : SCAN_KEY_UP,
+												 (uint8_t)(row * 8 + col));
+		}
+	}
+
+	if(keypad->rows)
+		*keypad->row_data = keypad->row_mask;
+
+	for(row = 0; row < scanner->encoder_count; row++){
+
+		encoder = &scanner->encoders[row];
+		state = hal_gpio_scan_encoder_state(encoder);
+
+		if(state == encoder->state)
+			continue;
+
+		encoder->count += gpio_encoder_table[(encoder->state << 2) | state];
+		encoder->state = state;
+
+		if(encoder->count >= (int8_t)encoder->steps_per_detent){
+			encoder->count = 0;
+			hal_gpio_scan_push(scanner, now, SCAN_ENCODER_CW, (uint8_t)row);
+		}
+		else if(encoder->count <= -(int8_t)encoder->steps_per_detent){
+			encoder->count = 0;
+			hal_gpio_scan_push(scanner, now, SCAN_ENCODER_CCW, (uint8_t)row);
+		}
+	}
+}
+
+/**
+	* @brief  Timer interrupt handler, acknowledges the timer and scans
+	* @param  *scanner : scanner
+	* @retval None
+	*/
+void hal_gpio_scan_handle_interrupt(gpio_scanner_t *scanner){
+
+	hal_timer_clear_timeout(scanner->TIMERx);
+	hal_gpio_scan_run(scanner);
+}
+
+/**
+	* @brief  Takes the oldest event from the FIFO
+	* @param  *scanner : scanner
+	* @param  *event : filled with the event
+	* @retval true if an event was available
+	*/
+bool hal_gpio_scan_get_event(gpio_scanner_t *scanner, gpio_scan_event_t *event){
+
+	uint16_t tail = scanner->tail;
+
+	if(tail == scanner->head)
+		return false;
+
+	/*Read the entry only after the head that published it*/
+	__DMB();
+
+	*event = scanner->fifo[tail & (GPIO_SCAN_FIFO_SIZE - 1)];
+	scanner->tail = tail + 1;
+
+	return true;
+}
@@ -0,0 +1,158 @@
+#ifndef HAL_GPIO_SCAN_H
+#define HAL_GPIO_SCAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_gpio.h"
+#include "hal_timer.h"
+
+
+/*Largest keypad and number of encoders of one scanner*/
+#define GPIO_SCAN_MAX_ROWS						(8)
+#define GPIO_SCAN_MAX_ENCODERS				(4)
+
+/*Depth of the event FIFO, power of two*/
+#define GPIO_SCAN_FIFO_SIZE						(32)
+
+/*Core cycles between driving a row and reading the columns*/
+#define GPIO_SCAN_ROW_SETTLE_CYCLES		(16)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                  Data Structures for the panel scanner                    */
+/*                                                                           */
+/*****************************************************************************/
+
+/*enum for the scanner events*/
+typedef enum{
+
+	SCAN_KEY_DOWN,
+	SCAN_KEY_UP,
+	SCAN_ENCODER_CW,
+	SCAN_ENCODER_CCW
+}gpio_scan_event_type;
+
+/*One scanner event*/
+typedef struct{
+
+	uint32_t	timestamp;							/*DWT cycle count of the scan that saw it*/
+	uint8_t		type;										/*type "gpio_scan_event_type"*/
+	uint8_t		source;									/*key: row * 8 + column pin number, encoder: index*/
+
+}gpio_scan_event_t;
+
+/*Key matrix: rows are open drain outputs pulled low one at a time, columns are pulled up inputs*/
+typedef struct{
+
+	volatile uint32_t	*row_data;				/*GPIODATA with every row pin unmasked*/
+	volatile uint32_t	*col_data;				/*GPIODATA with every column pin unmasked*/
+	uint8_t						row_mask;					/*all row pins*/
+	uint8_t						col_mask;					/*all column pins*/
+	uint8_t						row_pins[GPIO_SCAN_MAX_ROWS];	/*pin mask of each row*/
+	uint8_t						rows;
+	uint8_t						state[GPIO_SCAN_MAX_ROWS];		/*debounced keys of each row, 1 = pressed*/
+	uint8_t						sample[GPIO_SCAN_MAX_ROWS];		/*previous raw sample of each row*/
+
+}gpio_keypad_t;
+
+/*Quadrature encoder*/
+typedef struct{
+
+	volatile uint32_t	*data;						/*GPIODATA with A and B unmasked*/
+	uint8_t						a_mask;
+	uint8_t						b_mask;
+	uint8_t						state;						/*last AB state, A in bit 1*/
+	int8_t						count;						/*quarter steps since the last event*/
+	uint8_t						steps_per_detent;	/*quarter steps per reported event*/
+
+}gpio_encoder_t;
+
+/*Panel scanner*/
+typedef struct{
+
+	TIMER0_Type				*TIMERx;					/*timer pacing the scans, NULL if scanned by the caller*/
+	gpio_keypad_t			keypad;						/*rows = 0 when there is no keypad*/
+	gpio_encoder_t		encoders[GPIO_SCAN_MAX_ENCODERS];
+	uint8_t						encoder_count;
+	gpio_scan_event_t	fifo[GPIO_SCAN_FIFO_SIZE];
+	volatile uint16_t	head;							/*free running write index, only written by the scan*/
+	volatile uint16_t	tail;							/*free running read index, only written by the consumer*/
+	volatile uint32_t	overruns;					/*events dropped because the FIFO was full*/
+
+}gpio_scanner_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs for the panel scanner                           */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Resets a scanner, without keypad and encoders
+	* @param  *scanner : scanner
+	* @retval None
+	*/
+void hal_gpio_scan_init(gpio_scanner_t *scanner);
+
+/**
+	* @brief  Adds the key matrix, the port clocks must be enabled
+	* A key is accepted after two equal consecutive scans.
+	* @param  *scanner : scanner
+	* @param  row_port : port of the rows, type "gpio_port_number"
+	* @param  *row_pins : pin number of each row
+	* @param  rows : number of rows, 1 to GPIO_SCAN_MAX_ROWS
+	* @param  col_port : port of the columns, type "gpio_port_number"
+	* @param  col_mask : column pins as a mask (GPIO_PIN_x)
+	* @retval None
+	*/
+void hal_gpio_scan_add_keypad(gpio_scanner_t *scanner, gpio_port_number row_port, const uint8_t *row_pins,
+															uint8_t rows, gpio_port_number col_port, uint8_t col_mask);
+
+/**
+	* @brief  Adds a quadrature encoder with pulled up inputs, the port clock must be enabled
+	* @param  *scanner : scanner
+	* @param  port : port number of type "gpio_port_number"
+	* @param  pin_a : pin number of channel A
+	* @param  pin_b : pin number of channel B
+	* @param  steps_per_detent : quarter steps per event, 4 for most knobs
+	* @retval index of the encoder, used as event source
+	*/
+uint8_t hal_gpio_scan_add_encoder(gpio_scanner_t *scanner, gpio_port_number port, uint8_t pin_a,
+																	uint8_t pin_b, uint8_t steps_per_detent);
+
+/**
+	* @brief  Scans periodically from timer A of a block
+	* The handler of the timer must call hal_gpio_scan_handle_interrupt.
+	* @param  *scanner : scanner
+	* @param  timer : timer block of type "timer_number"
+	* @param  clock : timer clock in Hz
+	* @param  scan_hz : scans per second, fast enough for the encoders
+	* @retval None
+	*/
+void hal_gpio_scan_start(gpio_scanner_t *scanner, timer_number timer, uint32_t clock, uint32_t scan_hz);
+
+/**
+	* @brief  Runs one scan of the keypad and of every encoder
+	* @param  *scanner : scanner
+	* @retval None
+	*/
+void hal_gpio_scan_run(gpio_scanner_t *scanner);
+
+/**
+	* @brief  Timer interrupt handler, acknowledges the timer and scans
+	* @param  *scanner : scanner
+	* @retval None
+	*/
+void hal_gpio_scan_handle_interrupt(gpio_scanner_t *scanner);
+
+/**
+	* @brief  Takes the oldest event from the FIFO
+	* @param  *scanner : scanner
+	* @param  *event : filled with the event
+	* @retval true if an event was available
+	*/
+bool hal_gpio_scan_get_event(gpio_scanner_t *scanner, gpio_scan_event_t *event);
+
+#endif
@@ -0,0 +1,220 @@
+#include "hal_gpio_state.h"
+
+
+/**
+	* @brief  Reads the whole configuration of a port
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  *state : filled with the configuration
+	* @retval None
+	*/
+void hal_gpio_port_snapshot(GPIOA_Type *GPIOx, gpio_port_state_t *state){
+
+	state->dir = (uint8_t)GPIOx->DIR;
+	state->afsel = (uint8_t)GPIOx->AFSEL;
+	state->dr2r = (uint8_t)GPIOx->DR2R;
+	state->dr4r = (uint8_t)GPIOx->DR4R;
+	state->dr8r = (uint8_t)GPIOx->DR8R;
+	state->odr = (uint8_t)GPIOx->ODR;
+	state->pur = (uint8_t)GPIOx->PUR;
+	state->pdr = (uint8_t)GPIOx->PDR;
+	state->slr = (uint8_t)GPIOx->SLR;
+	state->den = (uint8_t)GPIOx->DEN;
+	state->amsel = (uint8_t)GPIOx->AMSEL;
+	state->is = (uint8_t)GPIOx->IS;
+	state->ibe = (uint8_t)GPIOx->IBE;
+	state->iev = (uint8_t)GPIOx->IEV;
+	state->im = (uint8_t)GPIOx->IM;
+	state->pctl = GPIOx->PCTL;
+}
+
+/**
+	* @brief  Pins whose configuration differs between two states
+	* @param  *current : state of the port
+	* @param  *target : wanted state
+	* @param  registers : GPIO_STATE_xxx registers to look at
+	* @retval pin mask
+	*/
+static uint8_t hal_gpio_port_changed_pins(const gpio_port_state_t *current, const gpio_port_state_t *target,
+																					uint32_t registers){
+
+	uint8_t pins = 0;
+	uint32_t pctl;
+	uint8_t pin;
+
+	if(registers & GPIO_STATE_AFSEL)	pins |= current->afsel ^ target->afsel;
+	if(registers & GPIO_STATE_PUR)		pins |= current->pur ^ target->pur;
+	if(registers & GPIO_STATE_PDR)		pins |= current->pdr ^ target->pdr;
+	if(registers & GPIO_STATE_DEN)		pins |= current->den ^ target->den;
+	if(registers & GPIO_STATE_SENSE)
+		pins |= (current->is ^ target->is) | (current->ibe ^ target->ibe) | (current->iev ^ target->iev);
+
+	if(registers & GPIO_STATE_PCTL){
+		pctl = current->pctl ^ target->pctl;
+		for(pin = 0; pin < 8; pin++){
+			if(pctl & (0x0FUL << (pin * 4)))
+				pins |= (1 << pin);
+		}
+	}
+
+	return pins;
+}
+
+/**
+	* @brief  Compares two port states
+	* @param  *current : state of the port
+	* @param  *target : wanted state
+	* @retval GPIO_STATE_xxx registers that differ, 0 if none
+	*/
+uint32_t hal_gpio_port_diff(const gpio_port_state_t *current, const gpio_port_state_t *target){
+
+	uint32_t diff = 0;
+
+	if(current->dir != target->dir)				diff |= GPIO_STATE_DIR;
+	if(current->afsel != target->afsel)		diff |= GPIO_STATE_AFSEL;
+	if(current->pctl != target->pctl)			diff |= GPIO_STATE_PCTL;
+	if((current->dr2r != target->dr2r) || (current->dr4r != target->dr4r) || (current->dr8r != target->dr8r))
+		diff |= GPIO_STATE_DRIVE;
+	if(current->odr != target->odr)				diff |= GPIO_STATE_ODR;
+	if(current->pur != target->pur)				diff |= GPIO_STATE_PUR;
+	if(current->pdr != target->pdr)				diff |= GPIO_STATE_PDR;
+	if(current->slr != target->slr)				diff |= GPIO_STATE_SLR;
+	if(current->den != target->den)				diff |= GPIO_STATE_DEN;
+	if(current->amsel != target->amsel)		diff |= GPIO_STATE_AMSEL;
+	if((current->is != target->is) || (current->ibe != target->ibe) || (current->iev != target->iev))
+		diff |= GPIO_STATE_SENSE;
+	if(current->im != target->im)					diff |= GPIO_STATE_IM;
+
+	return diff;
+}
+
+/**
+	* @brief  Writes only the registers that differ between two states
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  *current : state of the port, e.g. from hal_gpio_port_snapshot
+	* @param  *target : wanted state
+	* @retval GPIO_STATE_xxx registers written
+	*/
+uint32_t hal_gpio_port_apply(GPIOA_Type *GPIOx, gpio_port_state_t *current, const gpio_port_state_t *target){
+
+	uint32_t diff = hal_gpio_port_diff(current, target);
+	uint8_t sense_pins = 0;
+	bool unlocked = false;
+
+	if(!diff)
+		return 0;
+
+	/*Open the commit register for the changed pins only*/
+	if(diff & GPIO_STATE_COMMIT_MASK){
+		GPIOx->LOCK = GPIO_LOCK_KEY;
+		GPIOx->CR = hal_gpio_port_changed_pins(current, target, GPIO_STATE_COMMIT_MASK);
+		unlocked = true;
+	}
+
+	/*Changing the sense can latch a false edge, keep those pins masked meanwhile*/
+	if(diff & GPIO_STATE_SENSE){
+		sense_pins = hal_gpio_port_changed_pins(current, target, GPIO_STATE_SENSE);
+		if(current->im & sense_pins)
+			GPIOx->IM = current->im & ~sense_pins;
+	}
+
+	/*Peripheral selection first, so a pin never drives with a stale mux*/
+	if(diff & GPIO_STATE_PCTL)		GPIOx->PCTL = target->pctl;
+	if(diff & GPIO_STATE_AFSEL)		GPIOx->AFSEL = target->afsel;
+	if(diff & GPIO_STATE_DIR)			GPIOx->DIR = target->dir;
+
+	/*Setting a DRxR bit clears it in the two others*/
+	if(diff & GPIO_STATE_DRIVE){
+		GPIOx->DR2R = target->dr2r;
+		GPIOx->DR4R = target->dr4r;
+		GPIOx->DR8R = target->dr8r;
+	}
+
+	if(diff & GPIO_STATE_ODR)			GPIOx->ODR = target->odr;
+	if(diff & GPIO_STATE_PUR)			GPIOx->PUR = target->pur;
+	if(diff & GPIO_STATE_PDR)			GPIOx->PDR = target->pdr;
+	if(diff & GPIO_STATE_SLR)			GPIOx->SLR = target->slr;
+	if(diff & GPIO_STATE_AMSEL)		GPIOx->AMSEL = target->amsel;
+	if(diff & GPIO_STATE_DEN)			GPIOx->DEN = target->den;
+
+	if(diff & GPIO_STATE_SENSE){
+		GPIOx->IS = target->is;
+		GPIOx->IBE = target->ibe;
+		GPIOx->IEV = target->iev;
+		GPIOx->ICR = sense_pins;
+	}
+
+	if((diff & (GPIO_STATE_IM | GPIO_STATE_SENSE)) && ((uint8_t)GPIOx->IM != target->im))
+		GPIOx->IM = target->im;
+
+	if(unlocked){
+		GPIOx->CR = 0;
+		GPIOx->LOCK = 0;
+	}
+
+	*current = *target;
+
+	return diff;
+}
+
+/**
+	* @brief  Edits a state: pin as digital GPIO
+	* @param  *state : state to edit
+	* @param  pin_no : GPIO pin number
+	* @param  mode : GPIO_PIN_INPUT_MODE or GPIO_PIN_OUTPUT_MODE
+	* @retval None
+	*/
+void hal_gpio_state_set_gpio(gpio_port_state_t *state, uint8_t pin_no, uint8_t mode){
+
+	uint8_t bit = (1 << pin_no);
+
+	state->afsel &= ~bit;
+	state->amsel &= ~bit;
+	state->den |= bit;
+	state->pctl &= ~(0x0FUL << (pin_no * 4));
+
+	if(mode == GPIO_PIN_OUTPUT_MODE)
+		state->dir |= bit;
+	else
+		state->dir &= ~bit;
+}
+
+/**
+	* @brief  Edits a state: pin as digital peripheral signal
+	* @param  *state : state to edit
+	* @param  pin_no : GPIO pin number
+	* @param  mux_value : PMCx encoding of the signal
+	* @retval None
+	*/
+void hal_gpio_state_set_alt(gpio_port_state_t *state, uint8_t pin_no, uint8_t mux_value){
+
+	uint8_t bit = (1 << pin_no);
+	uint32_t shift = pin_no * 4;
+
+	state->afsel |= bit;
+	state->amsel &= ~bit;
+	state->den |= bit;
+	state->pctl = (state->pctl & ~(0x0FUL << shift)) | ((uint32_t)(mux_value & 0x0F) << shift);
+}
+
+/**
+	* @brief  Edits a state: pull resistor or open drain of a pin
+	* @param  *state : state to edit
+	* @param  pin_no : GPIO pin number
+	* @param  register_config : GPIO_PIN_NO_PULL, PULL_UP, PULL_DOWN or OPEN_DRAIN
+	* @retval None
+	*/
+void hal_gpio_state_set_pull(gpio_port_state_t *state, uint8_t pin_no, uint8_t register_config){
+
+	uint8_t bit = (1 << pin_no);
+
+	state->pur &= ~bit;
+	state->pdr &= ~bit;
+	state->odr &= ~bit;
+
+	if(register_config == GPIO_PIN_PULL_UP)
+		state->pur |= bit;
+	else if(register_config == GPIO_PIN_PULL_DOWN)
+		state->pdr |= bit;
+	else if(register_config == GPIO_PIN_OPEN_DRAIN)
+		state->odr |= bit;
+}
@@ -0,0 +1,118 @@
+#ifndef HAL_GPIO_STATE_H
+#define HAL_GPIO_STATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_gpio.h"
+
+
+/*Registers of a port state, returned by hal_gpio_port_diff*/
+#define GPIO_STATE_DIR								(1 << 0)
+#define GPIO_STATE_AFSEL							(1 << 1)
+#define GPIO_STATE_PCTL								(1 << 2)
+#define GPIO_STATE_DRIVE							(1 << 3)			/*DR2R, DR4R and DR8R*/
+#define GPIO_STATE_ODR								(1 << 4)
+#define GPIO_STATE_PUR								(1 << 5)
+#define GPIO_STATE_PDR								(1 << 6)
+#define GPIO_STATE_SLR								(1 << 7)
+#define GPIO_STATE_DEN								(1 << 8)
+#define GPIO_STATE_AMSEL							(1 << 9)
+#define GPIO_STATE_SENSE							(1 << 10)			/*IS, IBE and IEV*/
+#define GPIO_STATE_IM									(1 << 11)
+
+/*Registers guarded by GPIOLOCK / GPIOCR on the locked pins*/
+#define GPIO_STATE_COMMIT_MASK				(GPIO_STATE_AFSEL | GPIO_STATE_PUR | GPIO_STATE_PDR | GPIO_STATE_DEN)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                  Data Structures for port snapshots                       */
+/*                                                                           */
+/*****************************************************************************/
+
+/*Configuration of a whole port, bit n of every mask is pin n*/
+typedef struct{
+
+	uint8_t		dir;
+	uint8_t		afsel;
+	uint8_t		dr2r;
+	uint8_t		dr4r;
+	uint8_t		dr8r;
+	uint8_t		odr;
+	uint8_t		pur;
+	uint8_t		pdr;
+	uint8_t		slr;
+	uint8_t		den;
+	uint8_t		amsel;
+	uint8_t		is;
+	uint8_t		ibe;
+	uint8_t		iev;
+	uint8_t		im;
+	uint32_t	pctl;										/*4 bits per pin*/
+
+}gpio_port_state_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs for port snapshots                              */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Reads the whole configuration of a port
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  *state : filled with the configuration
+	* @retval None
+	*/
+void hal_gpio_port_snapshot(GPIOA_Type *GPIOx, gpio_port_state_t *state);
+
+/**
+	* @brief  Compares two port states
+	* @param  *current : state of the port
+	* @param  *target : wanted state
+	* @retval GPIO_STATE_xxx registers that differ, 0 if none
+	*/
+uint32_t hal_gpio_port_diff(const gpio_port_state_t *current, const gpio_port_state_t *target);
+
+/**
+	* @brief  Writes only the registers that differ between two states
+	* GPIOLOCK / GPIOCR are opened for the changed pins when a committed
+	* register changes and locked again afterwards. Pins whose interrupt
+	* sense changes are masked while it changes and their stale flags cleared.
+	* "current" is updated to "target".
+	* @param  *GPIOx : GPIO Port Base address
+	* @param  *current : state of the port, e.g. from hal_gpio_port_snapshot
+	* @param  *target : wanted state
+	* @retval GPIO_STATE_xxx registers written
+	*/
+uint32_t hal_gpio_port_apply(GPIOA_Type *GPIOx, gpio_port_state_t *current, const gpio_port_state_t *target);
+
+/**
+	* @brief  Edits a state: pin as digital GPIO
+	* @param  *state : state to edit
+	* @param  pin_no : GPIO pin number
+	* @param  mode : GPIO_PIN_INPUT_MODE or GPIO_PIN_OUTPUT_MODE
+	* @retval None
+	*/
+void hal_gpio_state_set_gpio(gpio_port_state_t *state, uint8_t pin_no, uint8_t mode);
+
+/**
+	* @brief  Edits a state: pin as digital peripheral signal
+	* @param  *state : state to edit
+	* @param  pin_no : GPIO pin number
+	* @param  mux_value : PMCx encoding of the signal
+	* @retval None
+	*/
+void hal_gpio_state_set_alt(gpio_port_state_t *state, uint8_t pin_no, uint8_t mux_value);
+
+/**
+	* @brief  Edits a state: pull resistor or open drain of a pin
+	* @param  *state : state to edit
+	* @param  pin_no : GPIO pin number
+	* @param  register_config : GPIO_PIN_NO_PULL, PULL_UP, PULL_DOWN or OPEN_DRAIN
+	* @retval None
+	*/
+void hal_gpio_state_set_pull(gpio_port_state_t *state, uint8_t pin_no, uint8_t register_config);
+
+#endif
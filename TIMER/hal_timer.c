@@ -0,0 +1,78 @@
+#include "hal_timer.h"
+#include "hw_bitband.h"
+
+
+static TIMER0_Type * const timer_instances[TIMER_NUM_INSTANCES] = {
+	TIMER0, TIMER1, TIMER2, TIMER3, TIMER4, TIMER5
+};
+
+static const IRQn_Type timer_irq[TIMER_NUM_INSTANCES] = {
+	TIMER0A_IRQn, TIMER1A_IRQn, TIMER2A_IRQn, TIMER3A_IRQn, TIMER4A_IRQn, TIMER5A_IRQn
+};
+
+
+/**
+	* @brief  Configures timer A of a block as a 32 bit periodic down counter
+	* @param  timer : timer block of type "timer_number"
+	* @param  load : first interval in clock cycles
+	* @param  reload_on_timeout : true to let a new interval load take effect at the next timeout
+	* @retval TIMER0_Type* : base address of the block
+	*/
+TIMER0_Type *hal_timer_init_periodic(timer_number timer, uint32_t load, bool reload_on_timeout){
+
+	TIMER0_Type *TIMERx = timer_instances[timer];
+
+	/*Enable clock gating for the block and wait until it is ready*/
+	bitband_set(&SYSCTL->RCGCTIMER, timer);
+	while(!bitband_read(&SYSCTL->PRTIMER, timer));
+
+	bitband_clear(&TIMERx->CTL, GPTMCTL_REG_TAEN_FLAG_MASK);
+
+	TIMERx->CFG = GPTMCFG_32_BIT_TIMER;
+	TIMERx->TAMR = GPTMTAMR_TAMR_PERIODIC |
+								 ((reload_on_timeout ? 1 : 0) << GPTMTAMR_REG_TAILD_FLAG_MASK);
+	TIMERx->TAILR = load - 1;
+
+	TIMERx->ICR = (1 << GPTMIMR_REG_TATOIM_FLAG_MASK);
+	TIMERx->IMR = (1 << GPTMIMR_REG_TATOIM_FLAG_MASK);
+
+	NVIC_EnableIRQ(timer_irq[timer]);
+
+	return TIMERx;
+}
+
+/**
+	* @brief  Returns the NVIC number of timer A of a block
+	* @param  timer : timer block of type "timer_number"
+	* @retval IRQn_Type : interrupt number
+	*/
+IRQn_Type hal_timer_get_irq(timer_number timer){
+	return timer_irq[timer];
+}
+
+/**
+	* @brief  Starts timer A
+	* @param  *TIMERx : timer base address
+	* @retval None
+	*/
+void hal_timer_start(TIMER0_Type *TIMERx){
+	bitband_set(&TIMERx->CTL, GPTMCTL_REG_TAEN_FLAG_MASK);
+}
+
+/**
+	* @brief  Stops timer A
+	* @param  *TIMERx : timer base address
+	* @retval None
+	*/
+void hal_timer_stop(TIMER0_Type *TIMERx){
+	bitband_clear(&TIMERx->CTL, GPTMCTL_REG_TAEN_FLAG_MASK);
+}
+
+/**
+	* @brief  Acknowledges the timer A timeout interrupt
+	* @param  *TIMERx : timer base address
+	* @retval None
+	*/
+void hal_timer_clear_timeout(TIMER0_Type *TIMERx){
+	TIMERx->ICR = (1 << GPTMIMR_REG_TATOIM_FLAG_MASK);
+}
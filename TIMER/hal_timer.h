@@ -0,0 +1,101 @@
+#ifndef HAL_TIMER_H
+#define HAL_TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+
+
+/***************************************************************************************/
+/*                                                                                     */
+/*					Register Bit Definitions                                                   */
+/*                                                                                     */
+/***************************************************************************************/
+
+/*Bit definitions for GPTMCFG register*/
+#define GPTMCFG_32_BIT_TIMER														(0x0)
+
+/*Bit definitions for GPTMTAMR register*/
+#define GPTMTAMR_REG_TAILD_FLAG_MASK										(8)
+#define GPTMTAMR_REG_TACDIR_FLAG_MASK										(4)
+#define GPTMTAMR_TAMR_ONE_SHOT													(0x1)
+#define GPTMTAMR_TAMR_PERIODIC													(0x2)
+
+/*Bit definitions for GPTMCTL register*/
+#define GPTMCTL_REG_TASTALL_FLAG_MASK										(1)
+#define GPTMCTL_REG_TAEN_FLAG_MASK											(0)
+
+/*Bit definitions for GPTMIMR / GPTMRIS / GPTMMIS / GPTMICR registers*/
+#define GPTMIMR_REG_TATOIM_FLAG_MASK										(0)
+
+
+/*16/32 bit timer blocks*/
+#define TIMER_NUM_INSTANCES															(6)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                        Data Structures for Timer                          */
+/*                                                                           */
+/*****************************************************************************/
+
+/*enum for timer block number*/
+typedef enum{
+
+	timer_0,
+	timer_1,
+	timer_2,
+	timer_3,
+	timer_4,
+	timer_5
+
+}timer_number;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs to use Timer                                    */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Configures timer A of a block as a 32 bit periodic down counter
+	* The block clock is enabled, the timer is left stopped with its timeout
+	* interrupt unmasked and enabled in the NVIC.
+	* @param  timer : timer block of type "timer_number"
+	* @param  load : first interval in clock cycles
+	* @param  reload_on_timeout : true to let a new interval load take effect at the
+	*         next timeout instead of immediately (GPTMTAMR.TAILD)
+	* @retval TIMER0_Type* : base address of the block
+	*/
+TIMER0_Type *hal_timer_init_periodic(timer_number timer, uint32_t load, bool reload_on_timeout);
+
+/**
+	* @brief  Returns the NVIC number of timer A of a block
+	* @param  timer : timer block of type "timer_number"
+	* @retval IRQn_Type : interrupt number
+	*/
+IRQn_Type hal_timer_get_irq(timer_number timer);
+
+/**
+	* @brief  Starts timer A
+	* @param  *TIMERx : timer base address
+	* @retval None
+	*/
+void hal_timer_start(TIMER0_Type *TIMERx);
+
+/**
+	* @brief  Stops timer A
+	* @param  *TIMERx : timer base address
+	* @retval None
+	*/
+void hal_timer_stop(TIMER0_Type *TIMERx);
+
+/**
+	* @brief  Acknowledges the timer A timeout interrupt
+	* @param  *TIMERx : timer base address
+	* @retval None
+	*/
+void hal_timer_clear_timeout(TIMER0_Type *TIMERx);
+
+#endif
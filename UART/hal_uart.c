@@ -1,4 +1,6 @@
 #include "hal_uart.h"
+#include "cpu.h"
+#include "hw_bitband.h"
 
 /**
   * @brief  Enable UART
@@ -6,7 +8,7 @@
   * @retval None
   */
 void hal_uart_enable_uart_module(UART0_Type *uart){
-	uart->CTL |= (1 << UARTCTL_REG_UARTEN_FLAG_MASK);
+	bitband_set(&uart->CTL, UARTCTL_REG_UARTEN_FLAG_MASK);
 }
 
 /**
@@ -15,7 +17,7 @@ void hal_uart_enable_uart_module(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_uart_module(UART0_Type *uart){
-	uart->CTL &= ~(1 << UARTCTL_REG_UARTEN_FLAG_MASK);
+	bitband_clear(&uart->CTL, UARTCTL_REG_UARTEN_FLAG_MASK);
 }
 
 /**
@@ -24,7 +26,7 @@ void hal_uart_disable_uart_module(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_uart_Tx(UART0_Type *uart){
-	uart->CTL |= (1 << UARTCTL_REG_TXE_FLAG_MASK);
+	bitband_set(&uart->CTL, UARTCTL_REG_TXE_FLAG_MASK);
 }
 
 /**
@@ -33,7 +35,7 @@ void hal_uart_enable_uart_Tx(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_uart_Tx(UART0_Type *uart){
-	uart->CTL &= ~(1 << UARTCTL_REG_TXE_FLAG_MASK);
+	bitband_clear(&uart->CTL, UARTCTL_REG_TXE_FLAG_MASK);
 }
 
 /**
@@ -42,7 +44,7 @@ void hal_uart_disable_uart_Tx(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_uart_Rx(UART0_Type *uart){
-	uart->CTL |= (1 << UARTCTL_REG_RXE_FLAG_MASK);
+	bitband_set(&uart->CTL, UARTCTL_REG_RXE_FLAG_MASK);
 }
 
 
@@ -52,7 +54,7 @@ void hal_uart_enable_uart_Rx(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_uart_Rx(UART0_Type *uart){
-	uart->CTL &= ~(1 << UARTCTL_REG_RXE_FLAG_MASK);
+	bitband_clear(&uart->CTL, UARTCTL_REG_RXE_FLAG_MASK);
 }
 
 
@@ -69,28 +71,234 @@ void hal_uart_configure_clock_source(UART0_Type *uart, int8_t source_type){
 		uart->CC |= UART_CLOCK_SYSTEM;
 }
 
+/**
+  * @brief  computes the baud-rate divisor with integer arithmetic only
+  * @param  clock: UART clock in Hz
+  * @param  baudrate: requested baudrate
+  * @param  high_speed: true for HSE mode (clock / 8), false for clock / 16
+  * @param  divisor: receives the divisor, the achieved rate and its error
+  * @retval false if the rate cannot be generated from this clock
+  */
+bool hal_uart_compute_baud_divisor(uint32_t clock, uint32_t baudrate, bool high_speed, uart_baud_divisor_t *divisor){
+	
+	uint32_t clock_div = high_speed ? UART_CLOCK_DIV_HSE : UART_CLOCK_DIV;
+	uint32_t brd_x64;
+	
+	if(baudrate == 0)
+		return false;
+	
+	brd_x64 = UART_BRD_X64(clock, baudrate, clock_div);
+	
+	/*IBRD must be 1 - 65535, a zero IBRD with non zero FBRD is not allowed either*/
+	if((brd_x64 < 64) || ((brd_x64 >> 6) > 0xFFFF))
+		return false;
+	
+	divisor->ibrd = (uint16_t)(brd_x64 >> 6);
+	divisor->fbrd = (uint8_t)(brd_x64 & 0x3F);
+	divisor->actual_baudrate = (((64 / clock_div) * clock) + (brd_x64 / 2)) / brd_x64;
+	divisor->error_ppm = hal_uart_baud_error_ppm(clock, high_speed, divisor, baudrate);
+	
+	return true;
+}
+
+/**
+  * @brief  error of a divisor against a reference rate, from the exact ratio
+	* generated / reference = (64 * clock / clock_div) / (reference * brd_x64),
+	* both terms stay below 2^32. Only 32 bit divisions and one 32 x 32 -> 64
+	* bit multiply are used, no 64 bit division library call.
+  * @param  clock: UART clock in Hz
+  * @param  high_speed: true for HSE mode (clock / 8), false for clock / 16
+  * @param  divisor: divisor from hal_uart_compute_baud_divisor
+  * @param  baudrate: reference rate, the requested or a measured one
+  * @retval (generated - reference) / reference in parts per million, rounded
+  */
+int32_t hal_uart_baud_error_ppm(uint32_t clock, bool high_speed, const uart_baud_divisor_t *divisor, uint32_t baudrate){
+	
+	uint32_t clock_div = high_speed ? UART_CLOCK_DIV_HSE : UART_CLOCK_DIV;
+	uint32_t generated = (64 / clock_div) * clock;
+	uint32_t reference = baudrate * (((uint32_t)divisor->ibrd << 6) | divisor->fbrd);
+	uint32_t diff = (generated > reference) ? generated - reference : reference - generated;
+	uint32_t fraction = 0;
+	uint32_t ppm;
+	uint8_t bit;
+	
+	/*A rate off by a factor of two or more is no baudrate error anymore*/
+	if(diff >= reference)
+		return (generated > reference) ? INT32_MAX : INT32_MIN;
+	
+	/*24 fraction bits of diff / reference by restoring division, diff stays below reference*/
+	for(bit = 0; bit < 24; bit++){
+		fraction <<= 1;
+		if(diff >= reference - diff){
+			diff -= reference - diff;
+			fraction |= 1;
+		}
+		else{
+			diff <<= 1;
+		}
+	}
+	
+	ppm = (uint32_t)(((uint64_t)fraction * 1000000 + (1UL << 23)) >> 24);
+	
+	return (generated >= reference) ? (int32_t)ppm : -(int32_t)ppm;
+}
+
+/**
+  * @brief  writes a precomputed divisor, e.g. from UART_IBRD_VALUE / UART_FBRD_VALUE
+	* Takes effect on the next LCRH write.
+  * @param  uart: pointer to UART base address
+  * @param  ibrd: integer part of the divisor
+  * @param  fbrd: fractional part of the divisor
+  * @retval None
+  */
+void hal_uart_write_baud_divisor(UART0_Type *uart, uint32_t ibrd, uint32_t fbrd){
+	uart->IBRD = ibrd;
+	uart->FBRD = fbrd;
+}
+
 /**
   * @brief  configure baudrate for the communication
+	* Uses init.baudrate, init.clock and init.high_speed, the achieved error
+	* is stored in handle->baud_error_ppm. Takes effect on the next LCRH write.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval false if the rate cannot be generated, registers are left untouched
+  */
+bool hal_uart_configure_baudrate(uart_handle_t *handle){
+	
+	uint32_t clock = handle->init.clock ? handle->init.clock : UART_SYS_CLOCK;
+	uart_baud_divisor_t divisor;
+	
+	if(!hal_uart_compute_baud_divisor(clock, handle->init.baudrate, handle->init.high_speed, &divisor))
+		return false;
+	
+	bitband_write(&handle->instance->CTL, UARTCTL_REG_HSE_FLAG_MASK, handle->init.high_speed);
+	
+	hal_uart_write_baud_divisor(handle->instance, divisor.ibrd, divisor.fbrd);
+	handle->baud_error_ppm = divisor.error_ppm;
+	
+	return true;
+}
+
+/**
+  * @brief  computes the complete register image for a configuration, touches no register
+  * @param  init: pointer to the communication parameters
+  * @param  image: receives the register values
+  * @retval false if the baudrate cannot be generated
+  */
+bool hal_uart_build_config(const uart_init_t *init, uart_config_image_t *image){
+	
+	uart_baud_divisor_t divisor;
+	
+	if(!hal_uart_compute_baud_divisor(init->clock ? init->clock : UART_SYS_CLOCK,
+																		init->baudrate, init->high_speed, &divisor))
+		return false;
+	
+	image->ibrd = divisor.ibrd;
+	image->fbrd = divisor.fbrd;
+	image->error_ppm = divisor.error_ppm;
+	
+	image->lcrh = ((init->worldlength & 0x03) << UARTLCRH_REG_WLEN_FLAG_MASK);
+	if(init->fifo_mode)
+		image->lcrh |= (1 << UARTLCRH_REG_FEN_FLAG_MASK);
+	if(init->stopbits == UART_TWO_STOPBITS)
+		image->lcrh |= (1 << UARTLCRH_REG_STP2_FLAG_MASK);
+	if(init->nine_bit)
+		image->lcrh |= UART_LCRH_9BIT_DATA;
+	else if(init->parity == UART_ODD_PARITY)
+		image->lcrh |= (1 << UARTLCRH_REG_PEN_FLAG_MASK);
+	else if(init->parity == UART_EVEN_PARITY)
+		image->lcrh |= (1 << UARTLCRH_REG_PEN_FLAG_MASK) | (1 << UARTLCRH_REG_EPS_FLAG_MASK);
+	
+	image->ctl = (1 << UARTCTL_REG_UARTEN_FLAG_MASK) | (1 << UARTCTL_REG_TXE_FLAG_MASK) | (1 << UARTCTL_REG_RXE_FLAG_MASK);
+	if(init->high_speed)
+		image->ctl |= (1 << UARTCTL_REG_HSE_FLAG_MASK);
+	image->ctl |= init->flow_control & (UART_FLOW_CONTROL_RTS | UART_FLOW_CONTROL_CTS);
+	
+	image->ifls = ((init->rx_fifo_level & 0x07) << UARTIFLS_RXIFLSEL_MASK) |
+								((init->tx_fifo_level & 0x07) << UARTIFLS_TXIFLSEL_MASK);
+	
+	/*TXIM belongs to the transmit engine, it is never part of a static configuration*/
+	image->im = init->interrupt_mask & ~(1 << UARTIM_REG_TXIM_FLAG_MASK);
+	
+	image->nine_bit_addr = 0;
+	image->nine_bit_amask = UART9BITAMASK_REG_MASK_MASK;
+	if(init->nine_bit){
+		image->nine_bit_addr = (1 << UART9BITADDR_REG_9BITEN_FLAG_MASK) | init->address;
+		image->nine_bit_amask = init->address_mask;
+	}
+	
+	return true;
+}
+
+/**
+  * @brief  Waits until the uDMA frame, the TX ring, the TX FIFO and the shift register are empty
   * @param  handle: pointer to a uart_handle_t structure
   * @retval None
-	* For now the baud rate setting is limited to default system
-	* of 16 MHz AND for clock divisor of 16
   */
-void hal_uart_configure_baudrate(uart_handle_t *handle){
+static void hal_uart_wait_tx_idle(uart_handle_t *handle){
 	
-	uint32_t baurdrate = handle->init.baudrate;
+	while(handle->tx_dma_busy);
+	while(handle->tx_ring.tail != handle->tx_ring.head);
+	while((handle->instance->FR & ((1 << UARTFR_REG_TXFE_FLAG_MASK) | (1 << UARTFR_REG_BUSY_FLAG_MASK)))
+				!= (1 << UARTFR_REG_TXFE_FLAG_MASK));
+}
+
+/**
+  * @brief  commits a register image with the minimal ordered sequence of writes
+	* Waits for the TX FIFO and the character in flight to finish while the UART
+	* is still enabled, disables it, writes every register exactly once and
+	* re-enables it. A pending TX interrupt enable is kept so ring data queued
+	* meanwhile still goes out, with the new settings.
+  * @param  uart: pointer to UART base address
+  * @param  image: register values built by hal_uart_build_config
+  * @retval None
+  */
+void hal_uart_apply_config(UART0_Type *uart, const uart_config_image_t *image){
 	
-	/*Calculate integer part of the baud rate divisor*/
-	double BRD = (UART_SYS_CLOCK)/(baurdrate * UART_CLOCK_DIV);
+	uint32_t tx_pending = uart->IM & (1 << UARTIM_REG_TXIM_FLAG_MASK);
 	
-	/*Separate decimal and fractional part from the BRD*/
-	int32_t d_BRD = (int32_t)(BRD);
-	int32_t f_BRD = (BRD - d_BRD) * 1000;  /*multiplied by 1000 to get four decimal points precision*/	
+	/*A disabled UART never empties its FIFO and BUSY would stay set for good.
+	 *The old CTL bits (HSE, ...) stay until the last character is out.*/
+	if(uart->CTL & (1 << UARTCTL_REG_UARTEN_FLAG_MASK)){
+		while((uart->FR & ((1 << UARTFR_REG_TXFE_FLAG_MASK) | (1 << UARTFR_REG_BUSY_FLAG_MASK)))
+					!= (1 << UARTFR_REG_TXFE_FLAG_MASK));
+		bitband_clear(&uart->CTL, UARTCTL_REG_UARTEN_FLAG_MASK);
+	}
 	
-	/*set the d_BRD and f_BRD values into required register*/
-	handle->instance->IBRD = d_BRD;
-	handle->instance->FBRD = f_BRD;
+	/*IBRD and FBRD are latched by the LCRH write that follows them*/
+	uart->IBRD = image->ibrd;
+	uart->FBRD = image->fbrd;
+	uart->LCRH = image->lcrh;
+	uart->IFLS = image->ifls;
+	uart->_9BITAMASK = image->nine_bit_amask;
+	uart->_9BITADDR = image->nine_bit_addr;
+	uart->ICR = 0xFFFFFFFF;
+	uart->IM = image->im | tx_pending;
+	uart->CTL = image->ctl;
+}
 
+/**
+  * @brief  builds and commits the configuration held in handle->init
+	* Data already queued (ring or uDMA frame) goes out with the old settings
+	* first, so this waits and must not run from a priority above the UART's.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval false if the baudrate cannot be generated, registers are left untouched
+  */
+bool hal_uart_configure(uart_handle_t *handle){
+	
+	uart_config_image_t image;
+	
+	if(!hal_uart_build_config(&handle->init, &image))
+		return false;
+	
+	/*Only a running UART drains its TX path*/
+	if(handle->instance->CTL & (1 << UARTCTL_REG_UARTEN_FLAG_MASK))
+		hal_uart_wait_tx_idle(handle);
+	
+	hal_uart_apply_config(handle->instance, &image);
+	handle->baud_error_ppm = image.error_ppm;
+	
+	return true;
 }
 
 /**
@@ -100,7 +308,8 @@ void hal_uart_configure_baudrate(uart_handle_t *handle){
   */
 void hal_uart_configure_world_length(uart_handle_t *handle)
 {
-	handle->instance->LCRH |= (handle->init.worldlength << UARTLCRH_REG_WLEN_FLAG_MASK);
+	handle->instance->LCRH = (handle->instance->LCRH & ~(0x03 << UARTLCRH_REG_WLEN_FLAG_MASK)) |
+													 (handle->init.worldlength << UARTLCRH_REG_WLEN_FLAG_MASK);
 }
 
 /**
@@ -109,7 +318,7 @@ void hal_uart_configure_world_length(uart_handle_t *handle)
   * @retval None
   */
 void hal_uart_enable_fifo(UART0_Type *uart){
-	uart->LCRH |= (1 << UARTLCRH_REG_FEN_FLAG_MASK);
+	bitband_set(&uart->LCRH, UARTLCRH_REG_FEN_FLAG_MASK);
 }
 
 /**
@@ -118,7 +327,7 @@ void hal_uart_enable_fifo(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disble_fifo(UART0_Type *uart){
-	uart->LCRH &= ~(1 << UARTLCRH_REG_FEN_FLAG_MASK);
+	bitband_clear(&uart->LCRH, UARTLCRH_REG_FEN_FLAG_MASK);
 }
 
 /**
@@ -127,7 +336,8 @@ void hal_uart_disble_fifo(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_configure_stopbits(uart_handle_t *handle){
-	handle->instance->LCRH |= (handle->init.stopbits << UARTLCRH_REG_STP2_FLAG_MASK);
+	handle->instance->LCRH = (handle->instance->LCRH & ~(1 << UARTLCRH_REG_STP2_FLAG_MASK)) |
+													 (handle->init.stopbits << UARTLCRH_REG_STP2_FLAG_MASK);
 }
 
 /**
@@ -136,7 +346,7 @@ void hal_uart_configure_stopbits(uart_handle_t *handle){
   * @retval None
   */
 void hal_uart_enable_parity(UART0_Type *uart){
-	uart->LCRH |= (1 << UARTLCRH_REG_PEN_FLAG_MASK);
+	bitband_set(&uart->LCRH, UARTLCRH_REG_PEN_FLAG_MASK);
 }
 
 /**
@@ -145,7 +355,7 @@ void hal_uart_enable_parity(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_parity(UART0_Type *uart){
-	uart->LCRH &= ~(1 << UARTLCRH_REG_PEN_FLAG_MASK);
+	bitband_clear(&uart->LCRH, UARTLCRH_REG_PEN_FLAG_MASK);
 }
 
 /**
@@ -154,7 +364,7 @@ void hal_uart_disable_parity(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_even_parity(UART0_Type *uart){
-	uart->LCRH |= (1 << UARTLCRH_REG_EPS_FLAG_MASK);
+	bitband_set(&uart->LCRH, UARTLCRH_REG_EPS_FLAG_MASK);
 }
 
 /**
@@ -163,7 +373,7 @@ void hal_uart_enable_even_parity(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_odd_parity(UART0_Type *uart){
-	uart->LCRH &= ~(1 << UARTLCRH_REG_EPS_FLAG_MASK);
+	bitband_clear(&uart->LCRH, UARTLCRH_REG_EPS_FLAG_MASK);
 }
 
 
@@ -173,7 +383,7 @@ void hal_uart_enable_odd_parity(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_9bitMode_interrupt(UART0_Type *uart){
-	uart->IM |= (1 << UARTIM_REG_9BITIM_FLAG_MASK);
+	bitband_set(&uart->IM, UARTIM_REG_9BITIM_FLAG_MASK);
 }
 
 /**
@@ -182,7 +392,20 @@ void hal_uart_enable_9bitMode_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_9bitMode_interrupt(UART0_Type *uart){
-	uart->IM &= ~(1 << UARTIM_REG_9BITIM_FLAG_MASK);
+	bitband_clear(&uart->IM, UARTIM_REG_9BITIM_FLAG_MASK);
+}
+
+/**
+  * @brief  Changes the 9-bit mode address filter at run time
+  * @param  uart: pointer to UART base address
+  * @param  address: own address
+  * @param  address_mask: address bits compared, 0xFF = exact match
+  * @retval None
+  */
+void hal_uart_set_9bit_address(UART0_Type *uart, uint8_t address, uint8_t address_mask){
+	
+	uart->_9BITAMASK = address_mask;
+	uart->_9BITADDR = (uart->_9BITADDR & ~UART9BITADDR_REG_ADDR_MASK) | address;
 }
 
 /**
@@ -191,7 +414,7 @@ void hal_uart_disable_9bitMode_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_overrun_error_interrupt(UART0_Type *uart){
-	uart->IM |= (1 << UARTIM_REG_OEIM_FLAG_MASK);
+	bitband_set(&uart->IM, UARTIM_REG_OEIM_FLAG_MASK);
 }
 /**
   * @brief  Disables the overrun error interrupt
@@ -199,7 +422,7 @@ void hal_uart_enable_overrun_error_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_overrun_error_interrupt(UART0_Type *uart){
-	uart->IM &= ~(1 << UARTIM_REG_OEIM_FLAG_MASK);
+	bitband_clear(&uart->IM, UARTIM_REG_OEIM_FLAG_MASK);
 }
 /**
   * @brief  Enables the break error interrupt
@@ -207,7 +430,7 @@ void hal_uart_disable_overrun_error_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_break_error_interrupt(UART0_Type *uart){
-	uart->IM |= (1 << UARTIM_REG_BEIM_FLAG_MASK);
+	bitband_set(&uart->IM, UARTIM_REG_BEIM_FLAG_MASK);
 }
 
 /**
@@ -216,7 +439,7 @@ void hal_uart_enable_break_error_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_break_error_interrupt(UART0_Type *uart){
-	uart->IM &= ~(1 << UARTIM_REG_BEIM_FLAG_MASK);
+	bitband_clear(&uart->IM, UARTIM_REG_BEIM_FLAG_MASK);
 }
 
 /**
@@ -225,7 +448,7 @@ void hal_uart_disable_break_error_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_parity_error_interrupt(UART0_Type *uart){
-	uart->IM |= (1 << UARTIM_REG_PEIM_FLAG_MASK);
+	bitband_set(&uart->IM, UARTIM_REG_PEIM_FLAG_MASK);
 }
 
 /**
@@ -234,7 +457,7 @@ void hal_uart_enable_parity_error_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_parity_error_interrupt(UART0_Type *uart){
-	uart->IM &= ~(1 << UARTIM_REG_PEIM_FLAG_MASK);
+	bitband_clear(&uart->IM, UARTIM_REG_PEIM_FLAG_MASK);
 }
 /**
   * @brief  Enables the framing error interrupt
@@ -242,7 +465,7 @@ void hal_uart_disable_parity_error_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_framing_error_interrupt(UART0_Type *uart){
-	uart->IM |= (1 << UARTIM_REG_FEIM_FLAG_MASK);
+	bitband_set(&uart->IM, UARTIM_REG_FEIM_FLAG_MASK);
 }
 
 /**
@@ -251,7 +474,7 @@ void hal_uart_enable_framing_error_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_framing_error_interrupt(UART0_Type *uart){
-	uart->IM &= ~(1 << UARTIM_REG_FEIM_FLAG_MASK);
+	bitband_clear(&uart->IM, UARTIM_REG_FEIM_FLAG_MASK);
 }
 /**
   * @brief  Enables the receive time out interrupt
@@ -259,7 +482,7 @@ void hal_uart_disable_framing_error_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_receive_timeout_interrupt(UART0_Type *uart){
-	uart->IM |= (1 << UARTIM_REG_RTIM_FLAG_MASK);
+	bitband_set(&uart->IM, UARTIM_REG_RTIM_FLAG_MASK);
 }
 
 /**
@@ -268,7 +491,7 @@ void hal_uart_enable_receive_timeout_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_receive_timeout_interrupt(UART0_Type *uart){
-	uart->IM &= ~(1 << UARTIM_REG_RTIM_FLAG_MASK);
+	bitband_clear(&uart->IM, UARTIM_REG_RTIM_FLAG_MASK);
 }
 /**
   * @brief  Enables the Transmisstion interrupt
@@ -276,7 +499,7 @@ void hal_uart_disable_receive_timeout_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_tx_interrupt(UART0_Type *uart){
-	uart->IM |= (1 << UARTIM_REG_TXIM_FLAG_MASK);
+	bitband_set(&uart->IM, UARTIM_REG_TXIM_FLAG_MASK);
 }
 
 /**
@@ -285,7 +508,7 @@ void hal_uart_enable_tx_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_tx_interrupt(UART0_Type *uart){
-	uart->IM &= ~(1 << UARTIM_REG_TXIM_FLAG_MASK);
+	bitband_clear(&uart->IM, UARTIM_REG_TXIM_FLAG_MASK);
 }
 
 /**
@@ -294,7 +517,7 @@ void hal_uart_disable_tx_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_rx_interrupt(UART0_Type *uart){
-	uart->IM |= (1 << UARTIM_REG_RXIM_FLAG_MASK);
+	bitband_set(&uart->IM, UARTIM_REG_RXIM_FLAG_MASK);
 }
 /**
   * @brief  Disables the Receiver interrupt
@@ -302,7 +525,7 @@ void hal_uart_enable_rx_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_rx_interrupt(UART0_Type *uart){
-	uart->IM &= ~(1 << UARTIM_REG_RXIM_FLAG_MASK);
+	bitband_clear(&uart->IM, UARTIM_REG_RXIM_FLAG_MASK);
 }
 
 /**
@@ -311,7 +534,7 @@ void hal_uart_disable_rx_interrupt(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_rx_dma(UART0_Type *uart){
-	uart->DMACTL |= (1 << UARTDMACTL_REG_RXDMAE_FLAG_MASK);
+	bitband_set(&uart->DMACTL, UARTDMACTL_REG_RXDMAE_FLAG_MASK);
 }
 
 /**
@@ -320,7 +543,7 @@ void hal_uart_enable_rx_dma(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_rx_dma(UART0_Type *uart){
-	uart->DMACTL &= ~(1 << UARTDMACTL_REG_RXDMAE_FLAG_MASK);
+	bitband_clear(&uart->DMACTL, UARTDMACTL_REG_RXDMAE_FLAG_MASK);
 }
 /**
   * @brief  Enables the transmission using DMA
@@ -328,7 +551,7 @@ void hal_uart_disable_rx_dma(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_enable_tx_dma(UART0_Type *uart){
-	uart->DMACTL |= (1 << UARTDMACTL_REG_TXDMAE_FLAG_MASK);
+	bitband_set(&uart->DMACTL, UARTDMACTL_REG_TXDMAE_FLAG_MASK);
 }
 
 /**
@@ -337,5 +560,817 @@ void hal_uart_enable_tx_dma(UART0_Type *uart){
   * @retval None
   */
 void hal_uart_disable_tx_dma(UART0_Type *uart){
-	uart->DMACTL &= ~(1 << UARTDMACTL_REG_TXDMAE_FLAG_MASK);
-}
\ No newline at end of file
+	bitband_clear(&uart->DMACTL, UARTDMACTL_REG_TXDMAE_FLAG_MASK);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                  Interrupt driven ring buffer engine                       */
+/*                                                                            */
+/******************************************************************************/
+
+/*All counters at zero*/
+static const uart_stats_t uart_stats_zero;
+
+/**
+  * @brief  Moves bytes from the TX ring into the hardware FIFO until either is exhausted
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+static void hal_uart_fill_tx_fifo(uart_handle_t *handle){
+	
+	uart_ring_t *ring = &handle->tx_ring;
+	uint16_t tail = ring->tail;
+	uint16_t head = ring->head;
+	
+	while((tail != head) && !(handle->instance->FR & (1 << UARTFR_REG_TXFF_FLAG_MASK))){
+		handle->instance->DR = ring->buffer[tail & ring->mask];
+		tail++;
+	}
+	
+	handle->stats.tx_bytes += (uint16_t)(tail - ring->tail);
+	
+	/*Release the consumed slots to the producer with a single store*/
+	ring->tail = tail;
+}
+
+/**
+  * @brief  Moves every byte waiting in the hardware RX FIFO into the RX ring
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+static void hal_uart_drain_rx_fifo(uart_handle_t *handle){
+	
+	uart_ring_t *ring = &handle->rx_ring;
+	uint16_t head = ring->head;
+	uint16_t tail = ring->tail;
+	uint32_t data;
+	
+	while(!(handle->instance->FR & (1 << UARTFR_REG_RXFE_FLAG_MASK))){
+		
+		/*Always read DR so the FIFO keeps draining, even when the ring is full*/
+		data = handle->instance->DR;
+		
+		/*The error flags of the byte come with it, no extra register read*/
+		if(data & (0x0F << UARTD_REG_FE_FLAG_MASK)){
+			if(data & (1 << UARTD_REG_OE_FLAG_MASK))	handle->stats.overrun_errors++;
+			if(data & (1 << UARTD_REG_BE_FLAG_MASK))	handle->stats.break_errors++;
+			if(data & (1 << UARTD_REG_PE_FLAG_MASK))	handle->stats.parity_errors++;
+			if(data & (1 << UARTD_REG_FE_FLAG_MASK))	handle->stats.framing_errors++;
+		}
+		
+		if((uint16_t)(head - tail) > ring->mask){
+			handle->rx_dropped++;
+			continue;
+		}
+		
+		ring->buffer[head & ring->mask] = (uint8_t)data;
+		head++;
+	}
+	
+	handle->stats.rx_bytes += (uint16_t)(head - ring->head);
+	
+	/*Make the data visible before publishing the new head*/
+	__DMB();
+	ring->head = head;
+}
+
+/**
+  * @brief  Drives the RS-485 bus and returns the TX interrupt to FIFO level mode
+  * @param  handle: pointer to a uart_handle_t structure in RS-485 mode
+  * @retval None
+  */
+static void hal_uart_rs485_begin(uart_handle_t *handle){
+	
+	*handle->rs485_de = handle->rs485_de_assert;
+	bitband_clear(&handle->instance->CTL, UARTCTL_REG_EOT_FLAG_MASK);
+}
+
+/**
+  * @brief  Called once no more data is queued, releases the bus when the line is idle
+	* Otherwise the TX interrupt is moved to end of transmission and the
+	* release happens from that interrupt.
+  * @param  handle: pointer to a uart_handle_t structure in RS-485 mode
+  * @retval true if the bus was released
+  */
+static bool hal_uart_rs485_end(uart_handle_t *handle){
+	
+	UART0_Type *uart = handle->instance;
+	
+	bitband_set(&uart->CTL, UARTCTL_REG_EOT_FLAG_MASK);
+	
+	/*Stop bit of the last byte still on the line, wait for the EOT interrupt*/
+	if((uart->FR & ((1 << UARTFR_REG_TXFE_FLAG_MASK) | (1 << UARTFR_REG_BUSY_FLAG_MASK)))
+		 != (1 << UARTFR_REG_TXFE_FLAG_MASK))
+		return false;
+	
+	*handle->rs485_de = handle->rs485_de_release;
+	
+	return true;
+}
+
+/**
+  * @brief  Stops draining the RX FIFO once the RX ring reaches its high watermark
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+static void hal_uart_rx_throttle_check(uart_handle_t *handle){
+	
+	uart_ring_t *ring = &handle->rx_ring;
+	
+	if(!handle->rx_high_watermark || handle->rx_throttled || (handle->rx_state == UART_STATE_BUSY_RX))
+		return;
+	
+	if((uint16_t)(ring->head - ring->tail) < handle->rx_high_watermark)
+		return;
+	
+	handle->instance->IM &= ~((1 << UARTIM_REG_RXIM_FLAG_MASK) | (1 << UARTIM_REG_RTIM_FLAG_MASK));
+	handle->rx_throttled = true;
+	handle->stats.rx_throttles++;
+}
+
+/**
+  * @brief  Gives the RX FIFO back to the ISR, RXIM / RTIM as configured in init.interrupt_mask
+	* Nothing happens while the ring is throttled or a uDMA receive owns the FIFO.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+static void hal_uart_rx_resume(uart_handle_t *handle){
+	
+	if(handle->rx_throttled || (handle->rx_state == UART_STATE_BUSY_RX))
+		return;
+	
+	handle->instance->IM |= handle->init.interrupt_mask &
+													((1 << UARTIM_REG_RXIM_FLAG_MASK) | (1 << UARTIM_REG_RTIM_FLAG_MASK));
+}
+
+/**
+	* @brief  attaches the TX and RX ring storage to the handle
+	* @param  *handle : pointer to the handle structure 
+  * @param  *tx_buffer : storage for the TX ring
+  * @param  tx_size : size of the TX ring, must be a power of two (max 32768)
+  * @param  *rx_buffer : storage for the RX ring
+  * @param  rx_size : size of the RX ring, must be a power of two (max 32768)
+	* @retval None
+	*/
+void hal_uart_attach_buffers(uart_handle_t *handle, uint8_t *tx_buffer, uint16_t tx_size,
+														 uint8_t *rx_buffer, uint16_t rx_size){
+	
+	handle->tx_ring.buffer = tx_buffer;
+	handle->tx_ring.mask = tx_size - 1;
+	handle->tx_ring.head = 0;
+	handle->tx_ring.tail = 0;
+	
+	handle->rx_ring.buffer = rx_buffer;
+	handle->rx_ring.mask = rx_size - 1;
+	handle->rx_ring.head = 0;
+	handle->rx_ring.tail = 0;
+	
+	handle->rx_dropped = 0;
+	handle->rx_throttled = false;
+	handle->tx_dma_busy = false;
+	handle->stats = uart_stats_zero;
+}
+
+/**
+	* @brief  queues data for interrupt driven transmission, never blocks
+	* @param  *handle : pointer to the handle structure 
+  * @param  *buffer : pointer to the TX buffer 
+  * @param  len : length of the data
+	* @retval number of bytes queued, less than len if the TX ring is full
+	*/
+uint32_t hal_uart_tx(uart_handle_t *handle, uint8_t *buffer, uint32_t len){
+	
+	uart_ring_t *ring = &handle->tx_ring;
+	uint16_t head = ring->head;
+	uint32_t space = hal_uart_tx_space(handle);
+	uint32_t count;
+	
+	if(len > space)
+		len = space;
+	
+	if(len == 0)
+		return 0;
+	
+	for(count = 0; count < len; count++){
+		ring->buffer[(head + count) & ring->mask] = buffer[count];
+	}
+	
+	hal_uart_tx_commit(handle, len);
+	
+	return len;
+}
+
+/**
+	* @brief  copies already received data out of the RX ring, never blocks
+	* @param  *handle : pointer to the handle structure 
+  * @param  *buffer : pointer to the RX buffer 
+  * @param  len : length of the data
+	* @retval number of bytes copied into buffer
+	*/
+uint32_t hal_uart_rx(uart_handle_t *handle, uint8_t *buffer, uint32_t len){
+	
+	uart_ring_t *ring = &handle->rx_ring;
+	uint16_t tail = ring->tail;
+	uint32_t available = hal_uart_rx_available(handle);
+	uint32_t count;
+	
+	if(len > available)
+		len = available;
+	
+	for(count = 0; count < len; count++){
+		buffer[count] = ring->buffer[(tail + count) & ring->mask];
+	}
+	
+	hal_uart_rx_consume(handle, len);
+	
+	return len;
+}
+
+/**
+	* @brief  free slots of the TX ring
+	* @param  *handle : pointer to the handle structure 
+	* @retval bytes that can be written at the ring head
+	*/
+uint32_t hal_uart_tx_space(uart_handle_t *handle){
+	
+	uart_ring_t *ring = &handle->tx_ring;
+	
+	return (uint32_t)ring->mask + 1 - (uint16_t)(ring->head - ring->tail);
+}
+
+/**
+	* @brief  publishes bytes written straight into the TX ring and starts sending them
+	* While a uDMA TX frame is running they wait for its completion.
+	* @param  *handle : pointer to the handle structure 
+  * @param  len : bytes written from the ring head on, at most hal_uart_tx_space
+	* @retval None
+	*/
+void hal_uart_tx_commit(uart_handle_t *handle, uint32_t len){
+	
+	uart_ring_t *ring = &handle->tx_ring;
+	uint32_t primask;
+	
+	/*Make the data visible before publishing the new head*/
+	__DMB();
+	ring->head = (uint16_t)(ring->head + len);
+	
+	/*Prime the FIFO ourselves: the TX interrupt only fires when the FIFO level
+	 *crosses the trigger, so an idle transmitter would never ask for data.
+	 *The ISR is the only other consumer, keep it out while we act as one.*/
+	primask = CPUcpsid();
+	
+	/*A uDMA frame owns the FIFO, its completion sends the queued bytes*/
+	if(handle->tx_dma_busy){
+		if(!primask)
+			CPUcpsie();
+		return;
+	}
+	
+	handle->tx_state = UART_STATE_BUSY_TX;
+	if(handle->rs485_de)
+		hal_uart_rs485_begin(handle);
+	hal_uart_fill_tx_fifo(handle);
+
+	/*A write that fits in the FIFO never pushes the level through the trigger,
+	 *no TX interrupt would ever end it: the transfer is over right here.
+	 *In RS-485 mode the EOT interrupt releases the bus if the line is busy.*/
+	if((ring->tail == ring->head) && (!handle->rs485_de || hal_uart_rs485_end(handle))){
+		bitband_clear(&handle->instance->IM, UARTIM_REG_TXIM_FLAG_MASK);
+		handle->tx_state = UART_STATE_READY;
+	}
+	else{
+		bitband_set(&handle->instance->IM, UARTIM_REG_TXIM_FLAG_MASK);
+	}
+
+	if(!primask)
+		CPUcpsie();
+}
+
+/**
+	* @brief  received bytes waiting in the RX ring
+	* The bytes from the ring tail on may be read in place once this returned.
+	* @param  *handle : pointer to the handle structure 
+	* @retval number of bytes
+	*/
+uint32_t hal_uart_rx_available(uart_handle_t *handle){
+	
+	uart_ring_t *ring = &handle->rx_ring;
+	uint32_t available = (uint16_t)(ring->head - ring->tail);
+	
+	/*Do not read the data before the head that published it*/
+	__DMB();
+	
+	return available;
+}
+
+/**
+	* @brief  hands read RX ring slots back to the ISR
+	* @param  *handle : pointer to the handle structure 
+  * @param  len : bytes consumed from the ring tail on, at most hal_uart_rx_available
+	* @retval None
+	*/
+void hal_uart_rx_consume(uart_handle_t *handle, uint32_t len){
+	
+	uart_ring_t *ring = &handle->rx_ring;
+	uint32_t primask;
+	
+	/*Finish reading the slots before handing them back to the ISR*/
+	__DMB();
+	ring->tail = (uint16_t)(ring->tail + len);
+	
+	/*Down to the low watermark: the FIFO may be full with RTS deasserted and no
+	 *RX interrupt pending, drain it here as the producer with the ISR kept out*/
+	if(handle->rx_throttled && ((uint16_t)(ring->head - ring->tail) <= handle->rx_low_watermark)){
+		
+		primask = CPUcpsid();
+		
+		handle->rx_throttled = false;
+		
+		/*A uDMA receive owns the FIFO, its completion resumes the ring*/
+		if(handle->rx_state != UART_STATE_BUSY_RX){
+			hal_uart_drain_rx_fifo(handle);
+			hal_uart_rx_resume(handle);
+			hal_uart_rx_throttle_check(handle);
+		}
+		
+		if(!primask)
+			CPUcpsie();
+	}
+}
+
+/**
+  * @brief  Sends an address byte in 9-bit mode and queues the frame data after it
+  * @param  handle: pointer to a uart_handle_t structure, init.nine_bit set
+  * @param  address: destination address
+  * @param  buffer: frame data, may be NULL when len is 0
+  * @param  len: length of the frame data
+  * @retval number of data bytes queued
+  */
+uint32_t hal_uart_9bit_send(uart_handle_t *handle, uint8_t address, uint8_t *buffer, uint32_t len){
+	
+	UART0_Type *uart = handle->instance;
+	uint32_t lcrh;
+	
+	/*The 9th bit of the bytes already queued must not change under them*/
+	hal_uart_wait_tx_idle(handle);
+	
+	lcrh = uart->LCRH & ~UART_LCRH_9BIT_DATA;
+	uart->LCRH = lcrh | UART_LCRH_9BIT_ADDRESS;
+	
+	/*On a multidrop RS-485 bus the address byte needs the driver as well*/
+	if(handle->rs485_de)
+		hal_uart_rs485_begin(handle);
+	uart->DR = address;
+	
+	while((uart->FR & ((1 << UARTFR_REG_TXFE_FLAG_MASK) | (1 << UARTFR_REG_BUSY_FLAG_MASK)))
+				!= (1 << UARTFR_REG_TXFE_FLAG_MASK));
+	
+	uart->LCRH = lcrh | UART_LCRH_9BIT_DATA;
+	handle->stats.tx_bytes++;
+	
+	/*The line is idle, an address alone releases the bus at once*/
+	if(len == 0){
+		if(handle->rs485_de)
+			hal_uart_rs485_end(handle);
+		return 0;
+	}
+	
+	return hal_uart_tx(handle, buffer, len);
+}
+
+/******************************************************************************/
+/*                                                                            */
+/*                           uDMA binding                                     */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+  * @brief  Programs a channel for a frame, splitting it in scatter-gather tasks when needed
+  * @param  channel: uDMA channel
+  * @param  tasks: task list storage of at least UART_DMA_MAX_TASKS entries
+  * @param  flags: item size, increments and arbitration of the frame
+  * @param  src: source start address
+  * @param  dst: destination start address
+  * @param  len: frame length in bytes
+  * @retval None
+  */
+static void hal_uart_dma_program(uint8_t channel, udma_control_t *tasks, uint32_t flags,
+																 volatile uint8_t *src, volatile uint8_t *dst, uint32_t len){
+	
+	bool src_inc = (((flags >> UDMACHCTL_SRCINC_POS) & 0x03) != UDMA_INC_NONE);
+	uint16_t count = 0;
+	uint16_t chunk;
+	
+	hal_udma_reset_channel_attributes(channel);
+	
+	if(len <= UDMA_MAX_TRANSFER){
+		hal_udma_set_transfer(channel, flags, UDMA_MODE_BASIC, src, dst, (uint16_t)len);
+		return;
+	}
+	
+	/*Each task moves up to UDMA_MAX_TRANSFER bytes of the caller buffer in place*/
+	while(len){
+		chunk = (len > UDMA_MAX_TRANSFER) ? UDMA_MAX_TRANSFER : (uint16_t)len;
+		len -= chunk;
+		
+		hal_udma_build_transfer(&tasks[count], flags,
+														len ? UDMA_MODE_ALT_PER_SCATTER_GATHER : UDMA_MODE_BASIC,
+														src, dst, chunk);
+		if(src_inc)
+			src += chunk;
+		else
+			dst += chunk;
+		count++;
+	}
+	
+	hal_udma_set_scatter_gather(channel, tasks, count, true);
+}
+
+/**
+  * @brief  binds uDMA channels to the UART, hal_udma_init must have been called
+  * @param  handle: pointer to a uart_handle_t structure
+  * @param  tx_channel: uDMA channel for TX (UDMA_CHx_UARTnTX) or UART_DMA_NO_CHANNEL
+  * @param  rx_channel: uDMA channel for RX (UDMA_CHx_UARTnRX) or UART_DMA_NO_CHANNEL
+  * @param  encoding: CHMAP encoding of the UART (UDMA_ENC_UARTn)
+  * @retval None
+  */
+void hal_uart_configure_dma(uart_handle_t *handle, uint8_t tx_channel, uint8_t rx_channel, uint8_t encoding){
+	
+	handle->tx_dma_channel = tx_channel;
+	handle->rx_dma_channel = rx_channel;
+	
+	if(tx_channel != UART_DMA_NO_CHANNEL)
+		hal_udma_assign_channel(tx_channel, encoding);
+	
+	if(rx_channel != UART_DMA_NO_CHANNEL)
+		hal_udma_assign_channel(rx_channel, encoding);
+}
+
+/**
+  * @brief  transmits a frame straight from the caller buffer through the uDMA
+	* The buffer must stay untouched until tx_state returns to UART_STATE_READY.
+	* Refused while the TX ring is sending. Bytes queued with hal_uart_tx during
+	* the frame wait in the ring and go out right after it.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @param  buffer: frame to send
+  * @param  len: frame length, 1 to UART_DMA_MAX_FRAME
+  * @retval true if the transfer was started
+  */
+bool hal_uart_dma_tx(uart_handle_t *handle, uint8_t *buffer, uint32_t len){
+	
+	uint8_t channel = handle->tx_dma_channel;
+	uint32_t primask;
+	
+	if((channel == UART_DMA_NO_CHANNEL) || (len == 0) || (len > UART_DMA_MAX_FRAME))
+		return false;
+	
+	/*The ring engine and a uDMA frame never feed the FIFO together*/
+	primask = CPUcpsid();
+	
+	if(handle->tx_state != UART_STATE_READY){
+		if(!primask)
+			CPUcpsie();
+		return false;
+	}
+	
+	handle->tx_state = UART_STATE_BUSY_TX;
+	handle->tx_dma_busy = true;
+	
+	if(!primask)
+		CPUcpsie();
+	
+	if(handle->rs485_de)
+		hal_uart_rs485_begin(handle);
+	
+	hal_uart_dma_program(channel, handle->tx_dma_tasks,
+											 UDMA_CONTROL_FLAGS(UDMA_INC_NONE, UDMA_INC_8, UDMA_SIZE_8, UDMA_ARB_4),
+											 buffer, (volatile uint8_t *)&handle->instance->DR, len);
+	
+	hal_udma_enable_channel(channel);
+	hal_uart_enable_tx_dma(handle->instance);
+	
+	return true;
+}
+
+/**
+  * @brief  receives a frame straight into the caller buffer through the uDMA
+	* The RX interrupts are masked for the duration, rx_state returns to
+	* UART_STATE_READY once len bytes have arrived and the ring resumes.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @param  buffer: destination of the frame
+  * @param  len: frame length, 1 to UART_DMA_MAX_FRAME
+  * @retval true if the transfer was started
+  */
+bool hal_uart_dma_rx(uart_handle_t *handle, uint8_t *buffer, uint32_t len){
+	
+	uint8_t channel = handle->rx_dma_channel;
+	
+	if((channel == UART_DMA_NO_CHANNEL) || (len == 0) || (len > UART_DMA_MAX_FRAME))
+		return false;
+	
+	if(handle->rx_state != UART_STATE_READY)
+		return false;
+	
+	handle->rx_state = UART_STATE_BUSY_RX;
+	
+	/*The ISR would otherwise race the uDMA for the FIFO contents*/
+	hal_uart_disable_rx_interrupt(handle->instance);
+	hal_uart_disable_receive_timeout_interrupt(handle->instance);
+	
+	hal_uart_dma_program(channel, handle->rx_dma_tasks,
+											 UDMA_CONTROL_FLAGS(UDMA_INC_8, UDMA_INC_NONE, UDMA_SIZE_8, UDMA_ARB_4),
+											 (volatile uint8_t *)&handle->instance->DR, buffer, len);
+	
+	hal_udma_enable_channel(channel);
+	hal_uart_enable_rx_dma(handle->instance);
+	
+	return true;
+}
+
+/**
+  * @brief  Arms one half of the continuous receive buffer
+  * @param  handle: pointer to a uart_handle_t structure
+  * @param  alt: 0 for the primary structure / first half, 1 for the alternate / second half
+  * @retval None
+  */
+static void hal_uart_arm_pingpong_half(uart_handle_t *handle, uint8_t alt){
+	
+	hal_udma_set_transfer(handle->rx_dma_channel | (alt ? UDMA_ALT_SELECT : 0),
+												UDMA_CONTROL_FLAGS(UDMA_INC_8, UDMA_INC_NONE, UDMA_SIZE_8, UDMA_ARB_8),
+												UDMA_MODE_PINGPONG,
+												&handle->instance->DR,
+												handle->rx_pingpong_buffer + (alt ? handle->rx_pingpong_half : 0),
+												handle->rx_pingpong_half);
+}
+
+/**
+  * @brief  starts continuous reception into a double buffer using uDMA ping-pong
+	* Each completed half is handed to callback by pointer, without copying.
+	* The receive timeout interrupt hands out partially filled halves so the
+	* latency stays bounded on a quiet line. A block must be consumed before
+	* the uDMA wraps around to the same half again.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @param  buffer: storage for both halves, 2 * half_size bytes
+  * @param  half_size: bytes per half, 1 to UDMA_MAX_TRANSFER
+  * @param  callback: receives each block, called from the UART ISR
+  * @retval true if reception was started
+  */
+bool hal_uart_start_continuous_rx(uart_handle_t *handle, uint8_t *buffer, uint16_t half_size,
+																	uart_rx_block_callback_t callback){
+	
+	UART0_Type *uart = handle->instance;
+	uint8_t channel = handle->rx_dma_channel;
+	
+	if((channel == UART_DMA_NO_CHANNEL) || (half_size == 0) || (half_size > UDMA_MAX_TRANSFER))
+		return false;
+	
+	if(handle->rx_state != UART_STATE_READY)
+		return false;
+	
+	handle->rx_state = UART_STATE_BUSY_RX;
+	handle->rx_pingpong_buffer = buffer;
+	handle->rx_pingpong_half = half_size;
+	handle->rx_pingpong_consumed = 0;
+	handle->rx_pingpong_alt = 0;
+	handle->rx_block_callback = callback;
+	
+	/*The uDMA owns the FIFO now, only the timeout is left to the ISR*/
+	hal_uart_disable_rx_interrupt(uart);
+	
+	/*Only burst requests are served: a tail shorter than the trigger level
+	 *stays in the FIFO and raises the receive timeout, which flushes it.
+	 *The burst size matches the 1/2 RX trigger level (8 bytes).*/
+	uart->IFLS = (uart->IFLS & ~(0x07 << UARTIFLS_RXIFLSEL_MASK)) | (UART_FIFO_LEVEL_1_2 << UARTIFLS_RXIFLSEL_MASK);
+	hal_udma_reset_channel_attributes(channel);
+	UDMA->USEBURSTSET = (1UL << channel);
+	
+	hal_uart_arm_pingpong_half(handle, 0);
+	hal_uart_arm_pingpong_half(handle, 1);
+	
+	hal_udma_enable_channel(channel);
+	hal_uart_enable_receive_timeout_interrupt(uart);
+	hal_uart_enable_rx_dma(uart);
+	
+	return true;
+}
+
+/**
+  * @brief  stops continuous reception and gives RX back to the interrupt driven ring
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+void hal_uart_stop_continuous_rx(uart_handle_t *handle){
+	
+	UART0_Type *uart = handle->instance;
+	
+	hal_uart_disable_rx_dma(uart);
+	hal_udma_disable_channel(handle->rx_dma_channel);
+	UDMA->USEBURSTCLR = (1UL << handle->rx_dma_channel);
+	
+	/*Back to the RX trigger level and interrupts of handle->init*/
+	uart->IFLS = (uart->IFLS & ~(0x07 << UARTIFLS_RXIFLSEL_MASK)) |
+							 ((handle->init.rx_fifo_level & 0x07) << UARTIFLS_RXIFLSEL_MASK);
+	hal_uart_disable_receive_timeout_interrupt(uart);
+	
+	handle->rx_pingpong_half = 0;
+	handle->rx_state = UART_STATE_READY;
+	
+	hal_uart_rx_resume(handle);
+}
+
+/**
+  * @brief  Hands out every completed half of the continuous receive buffer and re-arms it
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+static void hal_uart_complete_pingpong(uart_handle_t *handle){
+	
+	uint8_t alt = handle->rx_pingpong_alt;
+	uint8_t *block;
+	
+	/*Both halves may have completed if the ISR was held off, at most two passes*/
+	while(hal_udma_get_mode(handle->rx_dma_channel | (alt ? UDMA_ALT_SELECT : 0)) == UDMA_MODE_STOP){
+		
+		block = handle->rx_pingpong_buffer + (alt ? handle->rx_pingpong_half : 0);
+		
+		if(handle->rx_pingpong_consumed < handle->rx_pingpong_half)
+			handle->rx_block_callback(block + handle->rx_pingpong_consumed,
+																handle->rx_pingpong_half - handle->rx_pingpong_consumed);
+		
+		hal_uart_arm_pingpong_half(handle, alt);
+		
+		alt ^= 1;
+		handle->rx_pingpong_consumed = 0;
+	}
+	
+	handle->rx_pingpong_alt = alt;
+}
+
+/**
+  * @brief  Receive timeout in continuous mode: hands out the partially filled half
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+static void hal_uart_flush_pingpong(uart_handle_t *handle){
+	
+	uint32_t channel_bit = (1UL << handle->rx_dma_channel);
+	uint32_t timeout = UDMA_MAX_TRANSFER;
+	uint8_t alt;
+	uint16_t received;
+	
+	/*Let the uDMA pick up the short tail through single requests*/
+	UDMA->USEBURSTCLR = channel_bit;
+	while(!(handle->instance->FR & (1 << UARTFR_REG_RXFE_FLAG_MASK)) && --timeout);
+	UDMA->USEBURSTSET = channel_bit;
+	
+	/*The tail may have just completed a half*/
+	hal_uart_complete_pingpong(handle);
+	
+	alt = handle->rx_pingpong_alt;
+	received = handle->rx_pingpong_half - hal_udma_get_remaining(handle->rx_dma_channel | (alt ? UDMA_ALT_SELECT : 0));
+	
+	if(received > handle->rx_pingpong_consumed){
+		handle->rx_block_callback(handle->rx_pingpong_buffer + (alt ? handle->rx_pingpong_half : 0) + handle->rx_pingpong_consumed,
+															received - handle->rx_pingpong_consumed);
+		handle->rx_pingpong_consumed = received;
+	}
+}
+
+/**
+  * @brief  Completes uDMA frames, the uDMA signals them on the UART interrupt vector
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+static void hal_uart_handle_dma_completion(uart_handle_t *handle){
+	
+	uint32_t dmactl = handle->instance->DMACTL;
+	
+	if((dmactl & (1 << UARTDMACTL_REG_TXDMAE_FLAG_MASK)) && hal_udma_channel_done(handle->tx_dma_channel)){
+		hal_uart_disable_tx_dma(handle->instance);
+		handle->tx_dma_busy = false;
+		
+		/*Bytes queued by hal_uart_tx during the frame go out right behind it.
+		 *The last bytes are still in the FIFO, the TX interrupt finishes the frame.*/
+		hal_uart_fill_tx_fifo(handle);
+		if((handle->tx_ring.tail == handle->tx_ring.head) && (!handle->rs485_de || hal_uart_rs485_end(handle)))
+			handle->tx_state = UART_STATE_READY;
+		else
+			bitband_set(&handle->instance->IM, UARTIM_REG_TXIM_FLAG_MASK);
+	}
+	
+	if((dmactl & (1 << UARTDMACTL_REG_RXDMAE_FLAG_MASK)) && hal_udma_channel_done(handle->rx_dma_channel)){
+		
+		/*In continuous mode the channel keeps running on the other half*/
+		if(handle->rx_pingpong_half){
+			hal_uart_complete_pingpong(handle);
+		}
+		else{
+			hal_uart_disable_rx_dma(handle->instance);
+			handle->rx_state = UART_STATE_READY;
+			hal_uart_rx_resume(handle);
+		}
+	}
+}
+
+/**
+  * @brief  couples the RX ring level to the receiver backpressure
+  * @param  handle: pointer to a uart_handle_t structure, buffers attached
+  * @param  high_watermark: ring level that stops reception, 0 = off
+  * @param  low_watermark: ring level that resumes reception, below high_watermark
+  * @retval None
+  */
+void hal_uart_set_rx_watermarks(uart_handle_t *handle, uint16_t high_watermark, uint16_t low_watermark){
+	
+	uint32_t primask = CPUcpsid();
+	
+	handle->rx_low_watermark = low_watermark;
+	handle->rx_high_watermark = high_watermark;
+	
+	/*Turning the watermarks off must not leave the receiver stopped*/
+	if(!high_watermark && handle->rx_throttled){
+		handle->rx_throttled = false;
+		hal_uart_rx_resume(handle);
+	}
+	else{
+		hal_uart_rx_throttle_check(handle);
+	}
+	
+	if(!primask)
+		CPUcpsie();
+}
+
+/**
+  * @brief  switches the handle to RS-485 half-duplex mode
+  * @param  handle: pointer to a uart_handle_t structure
+  * @param  de_data: GPIODATA address with only the DE pin unmasked (GPIO_DATA_MASKED)
+  * @param  active_high: true if a high level drives the bus
+  * @retval None
+  */
+void hal_uart_enable_rs485(uart_handle_t *handle, volatile uint32_t *de_data, bool active_high){
+	
+	/*With a single pin unmasked, 0xFF sets it and 0x00 clears it*/
+	handle->rs485_de_assert = active_high ? 0xFF : 0x00;
+	handle->rs485_de_release = active_high ? 0x00 : 0xFF;
+	
+	*de_data = handle->rs485_de_release;
+	handle->rs485_de = de_data;
+}
+
+/**
+  * @brief  leaves RS-485 mode, DE is released
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+void hal_uart_disable_rs485(uart_handle_t *handle){
+	
+	if(!handle->rs485_de)
+		return;
+	
+	*handle->rs485_de = handle->rs485_de_release;
+	handle->rs485_de = 0;
+	bitband_clear(&handle->instance->CTL, UARTCTL_REG_EOT_FLAG_MASK);
+}
+
+/**
+  * @brief  handles various UART interrupt request.
+	* Reads MIS once, acknowledges every pending source with a single ICR write
+	* and then moves whole FIFO bursts between the hardware and the rings.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+void hal_uart_handle_interrupt(uart_handle_t *handle){
+	
+	UART0_Type *uart = handle->instance;
+	uint32_t status = uart->MIS;
+	
+	uart->ICR = status;
+	handle->stats.interrupts++;
+	
+	if(status & (1 << UARTIM_REG_9BITIM_FLAG_MASK))
+		handle->stats.address_matches++;
+	
+	hal_uart_handle_dma_completion(handle);
+	
+	if(handle->rx_pingpong_half){
+		if(status & (1 << UARTIM_REG_RTIM_FLAG_MASK))
+			hal_uart_flush_pingpong(handle);
+	}
+	else if(status & ((1 << UARTIM_REG_RXIM_FLAG_MASK) | (1 << UARTIM_REG_RTIM_FLAG_MASK))){
+		hal_uart_drain_rx_fifo(handle);
+		hal_uart_rx_throttle_check(handle);
+	}
+	
+	if(status & (1 << UARTIM_REG_TXIM_FLAG_MASK)){
+		
+		hal_uart_fill_tx_fifo(handle);
+		
+		/*Nothing left to send, stop the TX interrupt until hal_uart_tx queues more.
+		 *In RS-485 mode only once the bus is released, at end of transmission.*/
+		if((handle->tx_ring.tail == handle->tx_ring.head) && (!handle->rs485_de || hal_uart_rs485_end(handle))){
+			bitband_clear(&uart->IM, UARTIM_REG_TXIM_FLAG_MASK);
+			handle->tx_state = UART_STATE_READY;
+		}
+	}
+}
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include "tm4c123gh6pm.h"
+#include "hal_udma.h"
 
 /*@brief structure for different UART state*/
 typedef enum{
@@ -53,6 +54,9 @@ typedef enum{
 #define UARTLCRH_REG_BRK_FLAG_MASK											(0)
 
 /*Bit definitions for UARTCTL register*/
+#define UARTCTL_REG_CTSEN_FLAG_MASK											(15)
+#define UARTCTL_REG_RTSEN_FLAG_MASK											(14)
+#define UARTCTL_REG_RTS_FLAG_MASK												(11)
 #define UARTCTL_REG_RXE_FLAG_MASK												(9)
 #define UARTCTL_REG_TXE_FLAG_MASK												(8)
 #define UARTCTL_REG_LBE_FLAG_MASK												(7)
@@ -98,6 +102,13 @@ typedef enum{
 #define UARTICR_REG_CTSIM_FLAG_MASK											(1)
 
 
+/*Bit definitions for UART9BITADDR register*/
+#define UART9BITADDR_REG_9BITEN_FLAG_MASK								(15)
+#define UART9BITADDR_REG_ADDR_MASK											(0xFF)
+
+/*Bit definitions for UART9BITAMASK register*/
+#define UART9BITAMASK_REG_MASK_MASK											(0xFF)
+
 /*Bit definitions for UARTDMACTL, register*/
 #define UARTDMACTL_REG_DMAERR_FLAG_MASK									(2)
 #define UARTDMACTL_REG_TXDMAE_FLAG_MASK									(1)
@@ -107,6 +118,13 @@ typedef enum{
 #define UART_CLOCK_SYSTEM																(0)
 #define UART_CLOCK_PIOSC																(5)
 
+/*FIFO trigger levels for UARTIFLS*/
+#define UART_FIFO_LEVEL_1_8															(0)
+#define UART_FIFO_LEVEL_1_4															(1)
+#define UART_FIFO_LEVEL_1_2															(2)
+#define UART_FIFO_LEVEL_3_4															(3)
+#define UART_FIFO_LEVEL_7_8															(4)
+
 /*UART baudrates*/
 #define UART_BAUDRATE_4800															(uint32_t)(4800)
 #define UART_BAUDRATE_9600															(uint32_t)(9600)
@@ -114,8 +132,22 @@ typedef enum{
 
 #define UART_SYS_CLOCK																	(16000000)
 #define UART_CLOCK_DIV																	(16)
+#define UART_CLOCK_DIV_HSE															(8)
+
+/*Baud-rate divisor in 1/64 units, rounded to nearest: 64 * clock / (clock_div * baud).
+ *The IBRD/FBRD variants fold to constants when all arguments are constants,
+ *so fixed baud rates need no arithmetic at run time. clock must stay below
+ *2^32 / (128 / clock_div), i.e. 268 MHz in HSE mode.*/
+#define UART_BRD_X64(clock, baud, clock_div)						(((((128UL / (clock_div)) * (uint32_t)(clock)) / (uint32_t)(baud)) + 1) / 2)
+#define UART_IBRD_VALUE(clock, baud, clock_div)					(UART_BRD_X64(clock, baud, clock_div) >> 6)
+#define UART_FBRD_VALUE(clock, baud, clock_div)					(UART_BRD_X64(clock, baud, clock_div) & 0x3F)
 
 
+/*uDMA binding: frames longer than one uDMA transfer are split in scatter-gather tasks*/
+#define UART_DMA_MAX_TASKS															(4)
+#define UART_DMA_MAX_FRAME															(UART_DMA_MAX_TASKS * UDMA_MAX_TRANSFER)
+#define UART_DMA_NO_CHANNEL															(0xFF)
+
 /*Stop bits for the communication*/
 #define UART_ONE_STOPBIT																(0)
 #define UART_TWO_STOPBITS																(1)
@@ -125,6 +157,16 @@ typedef enum{
 #define UART_ODD_PARITY																	(1)
 #define UART_EVEN_PARITY									              (2)
 
+/*LCRH parity bits of 9-bit mode: sticky 1 marks an address byte, sticky 0 a data byte*/
+#define UART_LCRH_9BIT_ADDRESS													((1 << UARTLCRH_REG_SPS_FLAG_MASK) | (1 << UARTLCRH_REG_PEN_FLAG_MASK))
+#define UART_LCRH_9BIT_DATA															((1 << UARTLCRH_REG_SPS_FLAG_MASK) | (1 << UARTLCRH_REG_EPS_FLAG_MASK) | \
+																								 (1 << UARTLCRH_REG_PEN_FLAG_MASK))
+
+/*Hardware flow control, may be combined*/
+#define UART_FLOW_CONTROL_NONE													(0)
+#define UART_FLOW_CONTROL_RTS														(1 << UARTCTL_REG_RTSEN_FLAG_MASK)
+#define UART_FLOW_CONTROL_CTS														(1 << UARTCTL_REG_CTSEN_FLAG_MASK)
+
 /*FIFO mode*/
 #define UART_FIFO_ENABLED																(1)
 #define UART_FIFO_DISABLED															(0)
@@ -146,30 +188,114 @@ typedef enum{
 /*                                                                           */
 /*****************************************************************************/
 
+/*Baud-rate divisor and the rate it actually produces*/
+typedef struct{
+
+	uint16_t		ibrd;										/*integer part of the divisor*/
+	uint8_t			fbrd;										/*fractional part of the divisor in 1/64 units*/
+	uint32_t		actual_baudrate;				/*baudrate generated by ibrd/fbrd, rounded to whole baud*/
+	int32_t			error_ppm;							/*(actual - requested) / requested in parts per million, from the exact divisor*/
+
+}uart_baud_divisor_t;
+
+
 /*UART init structure definition*/
 typedef struct{
 
 	uint32_t 		baudrate;								/*specifies baudrate of the uart communication*/
+	uint32_t		clock;									/*specifies the UART clock in Hz, 0 = UART_SYS_CLOCK*/
+	bool				high_speed;							/*specifies HSE mode, 1 = clock / 8, 0 = clock / 16*/
 	uint32_t 		worldlength;						/*specifies number of bits per frame*/
 	uint32_t		stopbits;								/*specifies stop bits */
 	uint32_t 		parity;									/*specifies parity*/
 	//uint32_t 		mode;										/*specifies mode of communication Transmission or Reception*/
 	bool 				fifo_mode;							/*specifies whethe FIFO is enabled or not, 1 = enabled; 0 = disabled*/
+	uint32_t		tx_fifo_level;					/*specifies TX interrupt FIFO level, UART_FIFO_LEVEL_x*/
+	uint32_t		rx_fifo_level;					/*specifies RX interrupt FIFO level, UART_FIFO_LEVEL_x*/
+	uint32_t		interrupt_mask;					/*specifies UARTIM bits to enable, TXIM is managed by the driver*/
+	uint32_t		flow_control;						/*specifies UART_FLOW_CONTROL_x, RTS follows the RX FIFO, CTS gates TX*/
+	bool				nine_bit;								/*specifies 9-bit multidrop mode, parity is then used as address bit*/
+	uint8_t			address;								/*9-bit mode: own address*/
+	uint8_t			address_mask;						/*9-bit mode: address bits compared, 0xFF = exact match*/
 	
 }uart_init_t;
 
 
+/*Complete register image of a configuration, written in one ordered pass*/
+typedef struct{
+
+	uint32_t		ibrd;										/*UARTIBRD value*/
+	uint32_t		fbrd;										/*UARTFBRD value*/
+	uint32_t		lcrh;										/*UARTLCRH value*/
+	uint32_t		ctl;										/*UARTCTL value, written last*/
+	uint32_t		ifls;										/*UARTIFLS value*/
+	uint32_t		im;											/*UARTIM value*/
+	uint32_t		nine_bit_addr;					/*UART9BITADDR value, 0 = 9-bit mode off*/
+	uint32_t		nine_bit_amask;					/*UART9BITAMASK value*/
+	int32_t			error_ppm;							/*baudrate error of ibrd/fbrd*/
+
+}uart_config_image_t;
+
+
+/*Single producer / single consumer ring buffer used between application and ISR*/
+typedef struct{
+
+	uint8_t						*buffer;					/*ring storage, size must be a power of two*/
+	uint16_t					mask;							/*ring size - 1*/
+	volatile uint16_t	head;							/*free running write index, only written by the producer*/
+	volatile uint16_t	tail;							/*free running read index, only written by the consumer*/
+
+}uart_ring_t;
+
+
+/*Per instance counters, updated by the ISR core*/
+typedef struct{
+
+	uint32_t		interrupts;							/*serviced UART interrupts*/
+	uint32_t		tx_bytes;								/*bytes moved from the TX ring to the FIFO*/
+	uint32_t		rx_bytes;								/*bytes moved from the FIFO to the RX ring*/
+	uint32_t		overrun_errors;					/*bytes received with OE set*/
+	uint32_t		break_errors;						/*bytes received with BE set*/
+	uint32_t		parity_errors;					/*bytes received with PE set*/
+	uint32_t		framing_errors;					/*bytes received with FE set*/
+	uint32_t		address_matches;				/*9-bit mode: matching address bytes seen with 9BITIM enabled*/
+	uint32_t		rx_throttles;						/*times the RX ring reached its high watermark*/
+
+}uart_stats_t;
+
+
+/*Called from the ISR with a filled block of the continuous receive buffer*/
+typedef void (*uart_rx_block_callback_t)(uint8_t *block, uint32_t len);
+
+
 /*UART handle structure*/
 typedef struct{
 	
 	UART0_Type				*instance;			  /*UART register base address*/
 	uart_init_t				init;							/*UART communication initilization parameters*/
-	uint8_t 					*pTxBuffer;				/*pointer to transmit buffer*/
-	uint8_t						*pRxBuffer;				/*pointer to received buffer*/
-	uint16_t 					txBufferSize;			/*transfer buffer size*/
-	uint16_t					rxBufferSize;			/*received buffer size*/
-	uart_state_t			rx_state;					/*uart communication current state*/
-	uart_state_t			tx_state;					/*uart communication current state*/
+	uart_ring_t				tx_ring;					/*transmit ring, filled by hal_uart_tx and drained by the ISR*/
+	uart_ring_t				rx_ring;					/*receive ring, filled by the ISR and drained by hal_uart_rx*/
+	int32_t						baud_error_ppm;		/*error of the programmed baudrate, see hal_uart_compute_baud_divisor*/
+	volatile uint32_t	rx_dropped;				/*bytes discarded because the receive ring was full*/
+	uint16_t					rx_high_watermark;	/*ring level that stops draining the RX FIFO, 0 = off*/
+	uint16_t					rx_low_watermark;		/*ring level that resumes draining the RX FIFO*/
+	volatile bool			rx_throttled;				/*RX interrupts masked by the high watermark*/
+	uart_stats_t			stats;						/*traffic and error counters, cleared by hal_uart_attach_buffers*/
+	uint8_t						tx_dma_channel;		/*uDMA channel serving TX, UART_DMA_NO_CHANNEL if none*/
+	uint8_t						rx_dma_channel;		/*uDMA channel serving RX, UART_DMA_NO_CHANNEL if none*/
+	udma_control_t		tx_dma_tasks[UART_DMA_MAX_TASKS];	/*scatter-gather task list of the current TX frame*/
+	udma_control_t		rx_dma_tasks[UART_DMA_MAX_TASKS];	/*scatter-gather task list of the current RX frame*/
+	volatile bool			tx_dma_busy;			/*a uDMA TX frame owns the TX FIFO, ring data waits behind it*/
+	uint8_t						*rx_pingpong_buffer;	/*continuous receive buffer, two halves back to back*/
+	uint16_t					rx_pingpong_half;			/*bytes per half, 0 while continuous receive is off*/
+	uint16_t					rx_pingpong_consumed;	/*bytes of the active half already handed out*/
+	uint8_t						rx_pingpong_alt;			/*1 while the alternate structure fills the second half*/
+	uart_rx_block_callback_t	rx_block_callback;	/*receives each block of the continuous receive buffer*/
+	volatile uint32_t	*rs485_de;				/*GPIODATA of the DE pin with only that pin unmasked, NULL = RS-485 mode off*/
+	uint8_t						rs485_de_assert;	/*value written to drive the bus*/
+	uint8_t						rs485_de_release;	/*value written to release the bus*/
+	volatile uart_state_t			rx_state;					/*uart communication current state*/
+	volatile uart_state_t			tx_state;					/*uart communication current state*/
 
 }uart_handle_t;
 
@@ -181,22 +307,163 @@ typedef struct{
 /******************************************************************************/
 
 /**
-	* @brief  handles transmission of the data
+	* @brief  attaches the TX and RX ring storage to the handle
+	* @param  *handle : pointer to the handle structure 
+  * @param  *tx_buffer : storage for the TX ring
+  * @param  tx_size : size of the TX ring, must be a power of two (max 32768)
+  * @param  *rx_buffer : storage for the RX ring
+  * @param  rx_size : size of the RX ring, must be a power of two (max 32768)
+	* @retval None
+	*/
+void hal_uart_attach_buffers(uart_handle_t *handle, uint8_t *tx_buffer, uint16_t tx_size,
+														 uint8_t *rx_buffer, uint16_t rx_size);
+
+/**
+	* @brief  queues data for interrupt driven transmission, never blocks
 	* @param  *handle : pointer to the handle structure 
   * @param  *buffer : pointer to the TX buffer 
   * @param  len : length of the data
-	* @retval None
+	* @retval number of bytes queued, less than len if the TX ring is full
 	*/
-void hal_uart_tx(uart_handle_t *handle, uint8_t *buffer, uint32_t len);
+uint32_t hal_uart_tx(uart_handle_t *handle, uint8_t *buffer, uint32_t len);
 
 /**
-	* @brief  handles reception of the data
+	* @brief  copies already received data out of the RX ring, never blocks
 	* @param  *handle : pointer to the handle structure 
   * @param  *buffer : pointer to the RX buffer 
   * @param  len : length of the data
+	* @retval number of bytes copied into buffer
+	*/
+uint32_t hal_uart_rx(uart_handle_t *handle, uint8_t *buffer, uint32_t len);
+
+/**
+	* @brief  free slots of the TX ring
+	* @param  *handle : pointer to the handle structure 
+	* @retval bytes that can be written at the ring head
+	*/
+uint32_t hal_uart_tx_space(uart_handle_t *handle);
+
+/**
+	* @brief  publishes bytes written straight into the TX ring and starts sending them
+	* While a uDMA TX frame is running they wait for its completion.
+	* For producers that build their data in the ring, e.g. an encoder: write
+	* tx_ring.buffer[(tx_ring.head + n) & tx_ring.mask] for n < len, then commit.
+	* @param  *handle : pointer to the handle structure 
+  * @param  len : bytes written from the ring head on, at most hal_uart_tx_space
 	* @retval None
 	*/
-void hal_uart_rx(uart_handle_t *handle, uint8_t *buffer, uint32_t len);
+void hal_uart_tx_commit(uart_handle_t *handle, uint32_t len);
+
+/**
+	* @brief  received bytes waiting in the RX ring
+	* The bytes from the ring tail on may be read in place once this returned.
+	* @param  *handle : pointer to the handle structure 
+	* @retval number of bytes
+	*/
+uint32_t hal_uart_rx_available(uart_handle_t *handle);
+
+/**
+	* @brief  hands read RX ring slots back to the ISR
+	* @param  *handle : pointer to the handle structure 
+  * @param  len : bytes consumed from the ring tail on, at most hal_uart_rx_available
+	* @retval None
+	*/
+void hal_uart_rx_consume(uart_handle_t *handle, uint32_t len);
+
+/**
+  * @brief  binds uDMA channels to the UART, hal_udma_init must have been called
+  * @param  handle: pointer to a uart_handle_t structure
+  * @param  tx_channel: uDMA channel for TX (UDMA_CHx_UARTnTX) or UART_DMA_NO_CHANNEL
+  * @param  rx_channel: uDMA channel for RX (UDMA_CHx_UARTnRX) or UART_DMA_NO_CHANNEL
+  * @param  encoding: CHMAP encoding of the UART (UDMA_ENC_UARTn)
+  * @retval None
+  */
+void hal_uart_configure_dma(uart_handle_t *handle, uint8_t tx_channel, uint8_t rx_channel, uint8_t encoding);
+
+/**
+  * @brief  transmits a frame straight from the caller buffer through the uDMA
+	* The buffer must stay untouched until tx_state returns to UART_STATE_READY.
+	* Refused while the TX ring is sending. Bytes queued with hal_uart_tx during
+	* the frame wait in the ring and go out right after it.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @param  buffer: frame to send
+  * @param  len: frame length, 1 to UART_DMA_MAX_FRAME
+  * @retval true if the transfer was started
+  */
+bool hal_uart_dma_tx(uart_handle_t *handle, uint8_t *buffer, uint32_t len);
+
+/**
+  * @brief  receives a frame straight into the caller buffer through the uDMA
+	* The RX interrupts are masked for the duration, rx_state returns to
+	* UART_STATE_READY once len bytes have arrived and the ring resumes.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @param  buffer: destination of the frame
+  * @param  len: frame length, 1 to UART_DMA_MAX_FRAME
+  * @retval true if the transfer was started
+  */
+bool hal_uart_dma_rx(uart_handle_t *handle, uint8_t *buffer, uint32_t len);
+
+/**
+  * @brief  starts continuous reception into a double buffer using uDMA ping-pong
+	* Each completed half is handed to callback by pointer, without copying.
+	* The receive timeout interrupt hands out partially filled halves so the
+	* latency stays bounded on a quiet line. A block must be consumed before
+	* the uDMA wraps around to the same half again.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @param  buffer: storage for both halves, 2 * half_size bytes
+  * @param  half_size: bytes per half, 1 to UDMA_MAX_TRANSFER
+  * @param  callback: receives each block, called from the UART ISR
+  * @retval true if reception was started
+  */
+bool hal_uart_start_continuous_rx(uart_handle_t *handle, uint8_t *buffer, uint16_t half_size,
+																	uart_rx_block_callback_t callback);
+
+/**
+  * @brief  stops continuous reception and gives RX back to the interrupt driven ring
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+void hal_uart_stop_continuous_rx(uart_handle_t *handle);
+
+/**
+  * @brief  couples the RX ring level to the receiver backpressure
+	* When the ring holds high_watermark bytes the ISR masks RXIM / RTIM and
+	* stops draining the hardware FIFO. With UART_FLOW_CONTROL_RTS the
+	* hardware then deasserts RTS as the FIFO fills, and the sender pauses
+	* without a byte being lost. hal_uart_rx drains the FIFO and unmasks the
+	* interrupts again once the ring is down to low_watermark. Leave at least
+	* one FIFO (16 bytes) between high_watermark and the ring size.
+	* Not used by the uDMA receive paths.
+  * @param  handle: pointer to a uart_handle_t structure, buffers attached
+  * @param  high_watermark: ring level that stops reception, 0 = off
+  * @param  low_watermark: ring level that resumes reception, below high_watermark
+  * @retval None
+  */
+void hal_uart_set_rx_watermarks(uart_handle_t *handle, uint16_t high_watermark, uint16_t low_watermark);
+
+/**
+  * @brief  switches the handle to RS-485 half-duplex mode
+	* DE is asserted with one masked store before the first byte of a
+	* transmission. Once the TX ring is drained into the FIFO, the TX
+	* interrupt is moved to end of transmission (UARTCTL EOT) and DE is
+	* released from that interrupt, so the turnaround is bounded by the UART
+	* interrupt latency and no code polls BUSY. Data queued before the release
+	* keeps DE asserted, frames go out back to back. The DE pin must already
+	* be a digital output, e.g. through hal_uart_port_enable_rs485.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @param  de_data: GPIODATA address with only the DE pin unmasked (GPIO_DATA_MASKED)
+  * @param  active_high: true if a high level drives the bus
+  * @retval None
+  */
+void hal_uart_enable_rs485(uart_handle_t *handle, volatile uint32_t *de_data, bool active_high);
+
+/**
+  * @brief  leaves RS-485 mode, DE is released
+	* Must not be called while a transmission is in progress.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval None
+  */
+void hal_uart_disable_rs485(uart_handle_t *handle);
 
 /**
   * @brief  handles various UART interrupt request.
@@ -256,12 +523,76 @@ void hal_uart_enable_uart_Rx(UART0_Type *uart);
   */
 void hal_uart_disable_uart_Rx(UART0_Type *uart);
 
+/**
+  * @brief  computes the baud-rate divisor with integer arithmetic only
+  * @param  clock: UART clock in Hz
+  * @param  baudrate: requested baudrate
+  * @param  high_speed: true for HSE mode (clock / 8), false for clock / 16
+  * @param  divisor: receives the divisor, the achieved rate and its error
+  * @retval false if the rate cannot be generated from this clock
+  */
+bool hal_uart_compute_baud_divisor(uint32_t clock, uint32_t baudrate, bool high_speed, uart_baud_divisor_t *divisor);
+
+/**
+  * @brief  error of a divisor against a reference rate, from the exact ratio
+	* Integer arithmetic only, no 64 bit division.
+  * @param  clock: UART clock in Hz
+  * @param  high_speed: true for HSE mode (clock / 8), false for clock / 16
+  * @param  divisor: divisor from hal_uart_compute_baud_divisor
+  * @param  baudrate: reference rate, the requested or a measured one
+  * @retval (generated - reference) / reference in parts per million, rounded
+  */
+int32_t hal_uart_baud_error_ppm(uint32_t clock, bool high_speed, const uart_baud_divisor_t *divisor, uint32_t baudrate);
+
+/**
+  * @brief  writes a precomputed divisor, e.g. from UART_IBRD_VALUE / UART_FBRD_VALUE
+	* Takes effect on the next LCRH write.
+  * @param  uart: pointer to UART base address
+  * @param  ibrd: integer part of the divisor
+  * @param  fbrd: fractional part of the divisor
+  * @retval None
+  */
+void hal_uart_write_baud_divisor(UART0_Type *uart, uint32_t ibrd, uint32_t fbrd);
+
 /**
   * @brief  configure baudrate for the communication
+	* Uses init.baudrate, init.clock and init.high_speed, the achieved error
+	* is stored in handle->baud_error_ppm. Takes effect on the next LCRH write.
   * @param  handle: pointer to a uart_handle_t structure
+  * @retval false if the rate cannot be generated, registers are left untouched
+  */
+bool hal_uart_configure_baudrate(uart_handle_t *handle);
+
+/**
+  * @brief  computes the complete register image for a configuration, touches no register
+  * @param  init: pointer to the communication parameters
+  * @param  image: receives the register values
+  * @retval false if the baudrate cannot be generated
+  */
+bool hal_uart_build_config(const uart_init_t *init, uart_config_image_t *image);
+
+/**
+  * @brief  commits a register image with the minimal ordered sequence of writes
+	* Waits for the TX FIFO and the character in flight to finish while the UART
+	* is still enabled, disables it, writes every register exactly once and
+	* re-enables it. A pending TX interrupt enable is kept so ring data queued
+	* meanwhile still goes out, with the new settings.
+  * @param  uart: pointer to UART base address
+  * @param  image: register values built by hal_uart_build_config
   * @retval None
   */
-void hal_uart_configure_baudrate(uart_handle_t *handle);
+void hal_uart_apply_config(UART0_Type *uart, const uart_config_image_t *image);
+
+/**
+  * @brief  builds and commits the configuration held in handle->init
+	* Data already queued (ring or uDMA frame) goes out with the old settings
+	* first, so this waits and must not run from a priority above the UART's.
+	* Images for each protocol of a multi-protocol port can also be built once
+	* with hal_uart_build_config and switched with hal_uart_apply_config.
+  * @param  handle: pointer to a uart_handle_t structure
+  * @retval false if the baudrate cannot be generated, registers are left untouched
+  */
+bool hal_uart_configure(uart_handle_t *handle);
 
 /**
   * @brief  configure word length for the communication
@@ -333,6 +664,35 @@ void hal_uart_enable_9bitMode_interrupt(UART0_Type *uart);
   */
 void hal_uart_disable_9bitMode_interrupt(UART0_Type *uart);
 
+/**
+  * @brief  Changes the 9-bit mode address filter at run time
+	* In 9-bit mode the receiver drops every byte that follows a non matching
+	* address, so foreign frames cost no interrupt. An address matches when
+	* (received & address_mask) == (address & address_mask), e.g. a mask of
+	* 0xF0 with address 0x30 also answers the group 0x30-0x3F.
+  * @param  uart: pointer to UART base address
+  * @param  address: own address
+  * @param  address_mask: address bits compared, 0xFF = exact match
+  * @retval None
+  */
+void hal_uart_set_9bit_address(UART0_Type *uart, uint8_t address, uint8_t address_mask);
+
+/**
+  * @brief  Sends an address byte in 9-bit mode and queues the frame data after it
+	* Waits until the TX ring and the transmitter are empty, sends the address
+	* with the 9th bit set (sticky parity 1), waits until it is out and returns
+	* to data bytes (sticky parity 0) before queuing buffer with hal_uart_tx.
+	* Blocks for up to one ring and two characters, the TX interrupt must be able to run.
+	* The matched address byte is received into the FIFO of the addressed
+	* nodes ahead of the data, each frame in their RX ring starts with it.
+  * @param  handle: pointer to a uart_handle_t structure, init.nine_bit set
+  * @param  address: destination address
+  * @param  buffer: frame data, may be NULL when len is 0
+  * @param  len: length of the frame data
+  * @retval number of data bytes queued
+  */
+uint32_t hal_uart_9bit_send(uart_handle_t *handle, uint8_t address, uint8_t *buffer, uint32_t len);
+
 /**
   * @brief  Enables the overrun error interrupt
   * @param  uart: pointer to UART base address
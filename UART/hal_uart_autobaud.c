@@ -0,0 +1,222 @@
+#include "hal_uart_autobaud.h"
+
+
+/*Rates a detection can snap to*/
+static const uint32_t uart_standard_baudrates[] = {
+	1200, 2400, 4800, 9600, 14400, 19200, 38400, 57600, 115200, 230400, 460800, 921600
+};
+
+
+/**
+	* @brief  Returns the nearest standard rate when it is close enough
+	* @param  measured : measured rate
+	* @retval standard rate, or measured if none is within UART_AUTOBAUD_SNAP_PPM
+	*/
+static uint32_t hal_uart_autobaud_snap(uint32_t measured){
+
+	uint32_t index, distance;
+
+	for(index = 0; index < sizeof(uart_standard_baudrates) / sizeof(uart_standard_baudrates[0]); index++){
+
+		distance = (measured > uart_standard_baudrates[index]) ? measured - uart_standard_baudrates[index]
+																													 : uart_standard_baudrates[index] - measured;
+
+		if(((uint64_t)distance * 1000000) <= ((uint64_t)measured * UART_AUTOBAUD_SNAP_PPM))
+			return uart_standard_baudrates[index];
+	}
+
+	return measured;
+}
+
+/**
+	* @brief  Checks the edges of one character and adds its span to the average
+	* Every bit must last between half and one and a half nominal bit times.
+	* @param  *autobaud : detector with UART_AUTOBAUD_CHAR_EDGES edges collected
+	* @retval true if it was a clean sync character
+	*/
+static bool hal_uart_autobaud_add_char(uart_autobaud_t *autobaud){
+
+	gpio_edge_t *edges = autobaud->edges;
+	uint32_t span = edges[UART_AUTOBAUD_SPAN_BITS].timestamp - edges[0].timestamp;
+	uint32_t bit = span / UART_AUTOBAUD_SPAN_BITS;
+	uint32_t interval;
+	uint8_t index;
+
+	if(bit == 0)
+		return false;
+
+	for(index = 1; index < UART_AUTOBAUD_CHAR_EDGES; index++){
+		interval = edges[index].timestamp - edges[index - 1].timestamp;
+		if((interval < bit / 2) || (interval > bit + bit / 2))
+			return false;
+	}
+
+	if(autobaud->result.characters == 0){
+		autobaud->span_min = span;
+		autobaud->span_max = span;
+	}
+	else if(span < autobaud->span_min){
+		autobaud->span_min = span;
+	}
+	else if(span > autobaud->span_max){
+		autobaud->span_max = span;
+	}
+
+	autobaud->span_sum += span;
+	autobaud->result.characters++;
+
+	return true;
+}
+
+/**
+	* @brief  Gives the RX pin back to the UART, in its state from before the detection
+	* @param  *autobaud : detector
+	* @retval None
+	*/
+static void hal_uart_autobaud_release_pin(uart_autobaud_t *autobaud){
+
+	gpio_port_state_t current;
+
+	hal_gpio_capture_stop(autobaud->port, autobaud->rx_pin);
+
+	hal_gpio_port_snapshot(autobaud->GPIOx, &current);
+	hal_gpio_port_apply(autobaud->GPIOx, &current, &autobaud->saved);
+}
+
+/**
+	* @brief  Computes the rate from the averaged spans and reprograms the UART
+	* @param  *autobaud : detector
+	* @retval None
+	*/
+static void hal_uart_autobaud_finish(uart_autobaud_t *autobaud){
+
+	uart_handle_t *handle = autobaud->handle;
+	uart_autobaud_result_t *result = &autobaud->result;
+	uint32_t clock = handle->init.clock ? handle->init.clock : UART_SYS_CLOCK;
+	uint64_t bits = (uint64_t)UART_AUTOBAUD_SPAN_BITS * result->characters;
+	uart_baud_divisor_t divisor;
+
+	hal_uart_autobaud_release_pin(autobaud);
+
+	/*Rounded to nearest: cpu_clock * bits / cycles*/
+	result->measured_baudrate = (uint32_t)(((uint64_t)autobaud->cpu_clock * bits + autobaud->span_sum / 2) / autobaud->span_sum);
+	result->spread_ppm = (uint32_t)(((uint64_t)(autobaud->span_max - autobaud->span_min) * 1000000 * result->characters) /
+																	autobaud->span_sum);
+
+	result->baudrate = autobaud->snap ? hal_uart_autobaud_snap(result->measured_baudrate) : result->measured_baudrate;
+
+	if(!hal_uart_compute_baud_divisor(clock, result->baudrate, handle->init.high_speed, &divisor)){
+		result->baudrate = 0;
+		hal_uart_enable_uart_Rx(handle->instance);
+		return;
+	}
+
+	result->error_ppm = hal_uart_baud_error_ppm(clock, handle->init.high_speed, &divisor, result->measured_baudrate);
+
+	/*One ordered disable / write / enable pass, restarts the receiver as well*/
+	handle->init.baudrate = result->baudrate;
+	hal_uart_configure(handle);
+}
+
+/**
+	* @brief  Starts timing sync characters on the RX pin of an open module
+	* @param  *autobaud : detector, must stay valid until the detection ends
+	* @param  uart : open UART module of type "uart_number"
+	* @param  cpu_clock : core clock in Hz
+	* @param  characters : sync characters to average, 1 to UART_AUTOBAUD_MAX_CHARS
+	* @param  snap : program the nearest standard rate when within UART_AUTOBAUD_SNAP_PPM
+	* @retval None
+	*/
+void hal_uart_autobaud_start(uart_autobaud_t *autobaud, uart_number uart, uint32_t cpu_clock,
+														 uint8_t characters, bool snap){
+
+	const uart_instance_t *instance = hal_uart_port_get_instance(uart);
+	gpio_port_state_t current, target;
+
+	autobaud->handle = hal_uart_port_get_handle(uart);
+	autobaud->port = (gpio_port_number)instance->port;
+	autobaud->rx_pin = instance->rx_pin;
+	autobaud->GPIOx = hal_gpio_get_port(autobaud->port);
+	autobaud->cpu_clock = cpu_clock;
+	autobaud->snap = snap;
+	autobaud->wanted = (characters > UART_AUTOBAUD_MAX_CHARS) ? UART_AUTOBAUD_MAX_CHARS : characters;
+	autobaud->count = 0;
+	autobaud->span_sum = 0;
+	autobaud->result.measured_baudrate = 0;
+	autobaud->result.baudrate = 0;
+	autobaud->result.error_ppm = 0;
+	autobaud->result.spread_ppm = 0;
+	autobaud->result.characters = 0;
+	autobaud->result.rejected = 0;
+
+	if(autobaud->wanted == 0)
+		autobaud->wanted = 1;
+
+	hal_uart_disable_uart_Rx(autobaud->handle->instance);
+
+	/*RX pin to plain GPIO input, only AFSEL and PCTL change*/
+	hal_gpio_port_snapshot(autobaud->GPIOx, &autobaud->saved);
+	current = autobaud->saved;
+	target = autobaud->saved;
+	hal_gpio_state_set_gpio(&target, autobaud->rx_pin, GPIO_PIN_INPUT_MODE);
+	hal_gpio_port_apply(autobaud->GPIOx, &current, &target);
+
+	hal_gpio_capture_start(&autobaud->capture, autobaud->port, autobaud->rx_pin,
+												 autobaud->ring, UART_AUTOBAUD_RING_SIZE);
+}
+
+/**
+	* @brief  Checks the captured edges, reprograms the UART once enough sync characters are timed
+	* @param  *autobaud : detector
+	* @retval true once done, the outcome is in autobaud->result
+	*/
+bool hal_uart_autobaud_poll(uart_autobaud_t *autobaud){
+
+	gpio_edge_t edge;
+
+	while(hal_gpio_capture_read(&autobaud->capture, &edge, 1)){
+
+		/*A character starts with the falling edge of its start bit*/
+		if(autobaud->count == 0){
+			if(edge.level)
+				continue;
+		}
+		/*Levels must alternate, anything else was a glitch or a lost edge*/
+		else if(edge.level == autobaud->edges[autobaud->count - 1].level){
+			autobaud->result.rejected++;
+			autobaud->count = 0;
+			if(edge.level)
+				continue;
+		}
+
+		autobaud->edges[autobaud->count++] = edge;
+
+		if(autobaud->count < UART_AUTOBAUD_CHAR_EDGES)
+			continue;
+
+		autobaud->count = 0;
+
+		if(!hal_uart_autobaud_add_char(autobaud)){
+			autobaud->result.rejected++;
+			continue;
+		}
+
+		if(autobaud->result.characters == autobaud->wanted){
+			hal_uart_autobaud_finish(autobaud);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+	* @brief  Abandons a detection, the UART keeps its previous rate
+	* @param  *autobaud : detector
+	* @retval None
+	*/
+void hal_uart_autobaud_stop(uart_autobaud_t *autobaud){
+
+	hal_uart_autobaud_release_pin(autobaud);
+	hal_uart_enable_uart_Rx(autobaud->handle->instance);
+}
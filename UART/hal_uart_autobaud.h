@@ -0,0 +1,114 @@
+#ifndef HAL_UART_AUTOBAUD_H
+#define HAL_UART_AUTOBAUD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_uart.h"
+#include "hal_uart_port.h"
+#include "hal_gpio_state.h"
+#include "hal_gpio_capture.h"
+
+
+/*Sync character, 0x55 on the line with 8N1 is one edge per bit*/
+#define UART_AUTOBAUD_SYNC_CHAR					(0x55)
+
+/*Edges of one sync character: start bit falling edge to stop bit rising edge*/
+#define UART_AUTOBAUD_CHAR_EDGES				(10)
+
+/*Bit times between the first and the last falling edge of a sync character*/
+#define UART_AUTOBAUD_SPAN_BITS					(8)
+
+/*Edge ring of the detector, power of two*/
+#define UART_AUTOBAUD_RING_SIZE					(64)
+
+/*Most sync characters averaged in one detection*/
+#define UART_AUTOBAUD_MAX_CHARS					(8)
+
+/*Largest distance to a standard rate that is snapped to it, in ppm*/
+#define UART_AUTOBAUD_SNAP_PPM					(30000)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                  Data Structures for baud-rate detection                  */
+/*                                                                           */
+/*****************************************************************************/
+
+/*Outcome of a detection*/
+typedef struct{
+
+	uint32_t		measured_baudrate;			/*rate timed on the line*/
+	uint32_t		baudrate;								/*rate programmed, measured or snapped to a standard rate*/
+	int32_t			error_ppm;							/*(programmed divisor rate - measured) / measured*/
+	uint32_t		spread_ppm;							/*(slowest - fastest character) / average, timing uncertainty*/
+	uint8_t			characters;							/*sync characters averaged*/
+	uint8_t			rejected;								/*edge groups that were not a clean sync character*/
+
+}uart_autobaud_result_t;
+
+/*Detector of one UART*/
+typedef struct{
+
+	uart_handle_t				*handle;					/*handle of the open module*/
+	gpio_port_number		port;							/*port of the RX pin*/
+	uint8_t							rx_pin;
+	GPIOA_Type					*GPIOx;
+	gpio_port_state_t		saved;						/*port state to return to*/
+	gpio_capture_t			capture;
+	gpio_edge_t					ring[UART_AUTOBAUD_RING_SIZE];
+	gpio_edge_t					edges[UART_AUTOBAUD_CHAR_EDGES];	/*edges of the character being checked*/
+	uint8_t							count;						/*edges collected in edges[]*/
+	uint32_t						cpu_clock;				/*DWT clock in Hz*/
+	bool								snap;							/*program the nearest standard rate if close enough*/
+	uint8_t							wanted;						/*sync characters to average*/
+	uint64_t						span_sum;					/*sum of the character spans in cycles*/
+	uint32_t						span_min;
+	uint32_t						span_max;
+	uart_autobaud_result_t	result;
+
+}uart_autobaud_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs for baud-rate detection                         */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Starts timing sync characters on the RX pin of an open module
+	* The receiver is stopped and the RX pin is switched to a both edge GPIO
+	* input, every edge is time stamped with the DWT cycle counter. The peer
+	* must send UART_AUTOBAUD_SYNC_CHAR characters, 8 data bits, no parity.
+	* The timing error of one character is the interrupt jitter over 8 bit
+	* times, averaging characters reduces it. The edge rate is one interrupt
+	* per bit, about 115200 baud at 16 MHz is the practical limit.
+	* @param  *autobaud : detector, must stay valid until the detection ends
+	* @param  uart : open UART module of type "uart_number"
+	* @param  cpu_clock : core clock in Hz
+	* @param  characters : sync characters to average, 1 to UART_AUTOBAUD_MAX_CHARS
+	* @param  snap : program the nearest standard rate when within UART_AUTOBAUD_SNAP_PPM
+	* @retval None
+	*/
+void hal_uart_autobaud_start(uart_autobaud_t *autobaud, uart_number uart, uint32_t cpu_clock,
+														 uint8_t characters, bool snap);
+
+/**
+	* @brief  Checks the captured edges, reprograms the UART once enough sync characters are timed
+	* IBRD / FBRD are computed from the timing with integer arithmetic only,
+	* the pin goes back to the UART and the receiver is restarted.
+	* result.baudrate is 0 if the rate cannot be generated from the UART
+	* clock, the UART then keeps its previous rate.
+	* @param  *autobaud : detector
+	* @retval true once done, the outcome is in autobaud->result
+	*/
+bool hal_uart_autobaud_poll(uart_autobaud_t *autobaud);
+
+/**
+	* @brief  Abandons a detection, the UART keeps its previous rate
+	* @param  *autobaud : detector
+	* @retval None
+	*/
+void hal_uart_autobaud_stop(uart_autobaud_t *autobaud);
+
+#endif
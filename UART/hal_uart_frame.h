@@ -0,0 +1,143 @@
+#ifndef HAL_UART_FRAME_H
+#define HAL_UART_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_uart.h"
+
+
+/*COBS frame delimiter*/
+#define UART_FRAME_COBS_DELIMITER				(0x00)
+
+/*SLIP special characters (RFC 1055)*/
+#define UART_FRAME_SLIP_END							(0xC0)
+#define UART_FRAME_SLIP_ESC							(0xDB)
+#define UART_FRAME_SLIP_ESC_END					(0xDC)
+#define UART_FRAME_SLIP_ESC_ESC					(0xDD)
+
+/*Start value of hal_uart_frame_crc16 (CRC-16/CCITT-FALSE) and hal_uart_frame_crc32 (CRC-32/IEEE)*/
+#define UART_FRAME_CRC16_INIT						(0xFFFF)
+#define UART_FRAME_CRC32_INIT						(0x00000000)
+
+/*Encoded bytes gathered before they are handed to the TX engine*/
+#define UART_FRAME_PUBLISH_BYTES				(32)
+
+/*Worst case ring bytes of a frame of n bytes (payload + CRC), delimiters included*/
+#define UART_FRAME_COBS_MAX_ENCODED(n)	((n) + ((n) / 254) + 2)
+#define UART_FRAME_SLIP_MAX_ENCODED(n)	(2 * (n) + 2)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                  Data Structures for UART framing                         */
+/*                                                                           */
+/*****************************************************************************/
+
+/*enum for the byte stuffing*/
+typedef enum{
+
+	FRAME_COBS,
+	FRAME_SLIP
+}uart_frame_encoding;
+
+/*enum for the frame check*/
+typedef enum{
+
+	FRAME_CRC_NONE		= 0,							/*value is the CRC size in bytes*/
+	FRAME_CRC_16			= 2,
+	FRAME_CRC_32			= 4
+}uart_frame_crc;
+
+/*Framer of one UART handle*/
+typedef struct{
+
+	uart_handle_t			*handle;					/*rings of the UART*/
+	uint8_t						encoding;					/*type "uart_frame_encoding"*/
+	uint8_t						crc;							/*type "uart_frame_crc"*/
+	uint8_t						delimiter;				/*end of frame byte*/
+	bool							discarding;				/*an oversize frame is skipped up to its delimiter*/
+	uint16_t					max_encoded;			/*largest encoded frame accepted, delimiter excluded*/
+	uint16_t					scan;							/*free running RX ring index searched up to*/
+	uint16_t					pending;					/*RX ring bytes of the frame handed out, 0 if none*/
+	uint32_t					frames;						/*frames delivered*/
+	uint32_t					crc_errors;				/*frames dropped by the CRC check*/
+	uint32_t					decode_errors;		/*frames dropped for invalid stuffing*/
+	uint32_t					oversize;					/*frames dropped for exceeding max_encoded*/
+
+}uart_framer_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs for UART framing                                */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Binds a framer to a UART handle with attached buffers
+	* Received frames are decoded in place in the RX ring and handed out by
+	* pointer. A frame that wraps around the end of the ring is first made
+	* contiguous by copying its wrapped part behind the ring, so the RX ring
+	* storage given to hal_uart_attach_buffers must be rx_size + max_encoded
+	* bytes long (the ring itself still uses rx_size).
+	* @param  *framer : framer to fill
+	* @param  *handle : UART handle, rings attached
+	* @param  encoding : FRAME_COBS or FRAME_SLIP
+	* @param  crc : FRAME_CRC_NONE, FRAME_CRC_16 or FRAME_CRC_32
+	* @param  max_encoded : largest encoded frame in bytes, below the RX ring size
+	* @retval None
+	*/
+void hal_uart_frame_init(uart_framer_t *framer, uart_handle_t *handle, uart_frame_encoding encoding,
+												 uart_frame_crc crc, uint16_t max_encoded);
+
+/**
+	* @brief  Encodes a frame straight into the TX ring, never blocks
+	* The payload and its CRC (little endian) are stuffed byte by byte into
+	* the ring, no intermediate buffer. Encoded bytes are handed to the TX
+	* engine every UART_FRAME_PUBLISH_BYTES, the line starts moving before the
+	* whole frame is encoded. With SLIP and FRAME_CRC_NONE an empty payload
+	* is indistinguishable from the line noise flush and is not delivered.
+	* @param  *framer : framer
+	* @param  *payload : frame payload
+	* @param  len : payload length
+	* @retval false if the TX ring cannot take the worst case encoding, nothing queued
+	*/
+bool hal_uart_frame_send(uart_framer_t *framer, const uint8_t *payload, uint32_t len);
+
+/**
+	* @brief  Returns the next complete frame from the RX ring, never blocks
+	* Frames failing the decoding or the CRC are dropped and counted. The
+	* frame stays valid until hal_uart_frame_release or the next call.
+	* @param  *framer : framer
+	* @param  **frame : receives a pointer to the decoded payload, inside the RX ring storage
+	* @param  *len : receives the payload length, CRC excluded
+	* @retval true if a frame was returned
+	*/
+bool hal_uart_frame_receive(uart_framer_t *framer, uint8_t **frame, uint32_t *len);
+
+/**
+	* @brief  Hands the ring slots of the last received frame back to the UART
+	* @param  *framer : framer
+	* @retval None
+	*/
+void hal_uart_frame_release(uart_framer_t *framer);
+
+/**
+	* @brief  CRC-16/CCITT-FALSE, poly 0x1021, may be chained over several blocks
+	* @param  crc : UART_FRAME_CRC16_INIT or the result of the previous block
+	* @param  *data : data
+	* @param  len : length of the data
+	* @retval CRC
+	*/
+uint16_t hal_uart_frame_crc16(uint16_t crc, const uint8_t *data, uint32_t len);
+
+/**
+	* @brief  CRC-32/IEEE 802.3, poly 0x04C11DB7 reflected, may be chained over several blocks
+	* @param  crc : UART_FRAME_CRC32_INIT or the result of the previous block
+	* @param  *data : data
+	* @param  len : length of the data
+	* @retval CRC
+	*/
+uint32_t hal_uart_frame_crc32(uint32_t crc, const uint8_t *data, uint32_t len);
+
+#endif
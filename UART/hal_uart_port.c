@@ -0,0 +1,261 @@
+#include "hal_uart_port.h"
+#include "hal_gpio_state.h"
+#include "hw_bitband.h"
+
+
+/*Resources of every module, default pins of each UART (TM4C123GH6PM)*/
+static const uart_instance_t uart_instances[UART_INSTANCES] = {
+	{UART0, UART0_IRQn, port_a, 0, 1, 1, UDMA_CH9_UART0TX,  UDMA_CH8_UART0RX,  UDMA_ENC_UART0, UART_NO_FLOW_PINS, 0, 0, 0},
+	{UART1, UART1_IRQn, port_b, 0, 1, 1, UDMA_CH23_UART1TX, UDMA_CH22_UART1RX, UDMA_ENC_UART1, port_f, 0, 1, 1},
+	{UART2, UART2_IRQn, port_d, 6, 7, 1, UDMA_CH13_UART2TX, UDMA_CH12_UART2RX, UDMA_ENC_UART2, UART_NO_FLOW_PINS, 0, 0, 0},
+	{UART3, UART3_IRQn, port_c, 6, 7, 1, UDMA_CH17_UART3TX, UDMA_CH16_UART3RX, UDMA_ENC_UART3, UART_NO_FLOW_PINS, 0, 0, 0},
+	{UART4, UART4_IRQn, port_c, 4, 5, 1, UDMA_CH19_UART4TX, UDMA_CH18_UART4RX, UDMA_ENC_UART4, UART_NO_FLOW_PINS, 0, 0, 0},
+	{UART5, UART5_IRQn, port_e, 4, 5, 1, UDMA_CH7_UART5TX,  UDMA_CH6_UART5RX,  UDMA_ENC_UART5, UART_NO_FLOW_PINS, 0, 0, 0},
+	{UART6, UART6_IRQn, port_d, 4, 5, 1, UDMA_CH11_UART6TX, UDMA_CH10_UART6RX, UDMA_ENC_UART6, UART_NO_FLOW_PINS, 0, 0, 0},
+	{UART7, UART7_IRQn, port_e, 0, 1, 1, UDMA_CH21_UART7TX, UDMA_CH20_UART7RX, UDMA_ENC_UART7, UART_NO_FLOW_PINS, 0, 0, 0}
+};
+
+/*Handle serviced by each vector, NULL while the module is closed*/
+static uart_handle_t *uart_handles[UART_INSTANCES];
+
+
+/*IRQ handlers, one shared core for every module*/
+void UART0_Handler(void){
+	hal_uart_handle_interrupt(uart_handles[uart_0]);
+}
+
+void UART1_Handler(void){
+	hal_uart_handle_interrupt(uart_handles[uart_1]);
+}
+
+void UART2_Handler(void){
+	hal_uart_handle_interrupt(uart_handles[uart_2]);
+}
+
+void UART3_Handler(void){
+	hal_uart_handle_interrupt(uart_handles[uart_3]);
+}
+
+void UART4_Handler(void){
+	hal_uart_handle_interrupt(uart_handles[uart_4]);
+}
+
+void UART5_Handler(void){
+	hal_uart_handle_interrupt(uart_handles[uart_5]);
+}
+
+void UART6_Handler(void){
+	hal_uart_handle_interrupt(uart_handles[uart_6]);
+}
+
+void UART7_Handler(void){
+	hal_uart_handle_interrupt(uart_handles[uart_7]);
+}
+
+
+/**
+	* @brief  Returns the fixed resources of a UART module
+	* @param  uart : UART module of type "uart_number"
+	* @retval pointer to the table entry
+	*/
+const uart_instance_t *hal_uart_port_get_instance(uart_number uart){
+	return &uart_instances[uart];
+}
+
+/**
+	* @brief  Muxes the RX / TX pins of a module, only changed registers are written
+	* @param  *instance : table entry of the module
+	* @retval None
+	*/
+static void hal_uart_port_mux_pins(const uart_instance_t *instance){
+
+	gpio_port_number port = (gpio_port_number)instance->port;
+	GPIOA_Type *GPIOx;
+	gpio_port_state_t current, target;
+
+	hal_gpio_enable_clock(port);
+	GPIOx = hal_gpio_get_port(port);
+
+	hal_gpio_port_snapshot(GPIOx, &current);
+	target = current;
+
+	hal_gpio_state_set_alt(&target, instance->rx_pin, instance->mux_value);
+	hal_gpio_state_set_alt(&target, instance->tx_pin, instance->mux_value);
+	target.dir = (target.dir | (1 << instance->tx_pin)) & ~(1 << instance->rx_pin);
+
+	hal_gpio_port_apply(GPIOx, &current, &target);
+}
+
+/**
+	* @brief  Brings up a UART module and binds a handle to its interrupt
+	* @param  *handle : handle with init filled
+	* @param  uart : UART module of type "uart_number"
+	* @param  *tx_buffer : storage for the TX ring
+	* @param  tx_size : size of the TX ring, power of two
+	* @param  *rx_buffer : storage for the RX ring
+	* @param  rx_size : size of the RX ring, power of two
+	* @param  use_dma : bind the uDMA channels of the module
+	* @retval false if the baudrate cannot be generated, the module stays closed
+	*/
+bool hal_uart_port_open(uart_handle_t *handle, uart_number uart, uint8_t *tx_buffer, uint16_t tx_size,
+												uint8_t *rx_buffer, uint16_t rx_size, bool use_dma){
+
+	const uart_instance_t *instance = &uart_instances[uart];
+
+	/*Enable clock gating for the UART and wait until it is ready*/
+	bitband_set(&SYSCTL->RCGCUART, uart);
+	while(!bitband_read(&SYSCTL->PRUART, uart));
+
+	hal_uart_port_mux_pins(instance);
+
+	handle->instance = instance->base;
+	hal_uart_configure_clock_source(handle->instance, UART_CLOCK_SYSTEM);
+
+	/*Attach the TX/RX rings before the RX interrupts start filling them*/
+	hal_uart_attach_buffers(handle, tx_buffer, tx_size, rx_buffer, rx_size);
+
+	if(use_dma)
+		hal_uart_configure_dma(handle, instance->tx_dma_channel, instance->rx_dma_channel, instance->dma_encoding);
+	else
+		hal_uart_configure_dma(handle, UART_DMA_NO_CHANNEL, UART_DMA_NO_CHANNEL, 0);
+
+	if(!hal_uart_configure(handle)){
+		bitband_clear(&SYSCTL->RCGCUART, uart);
+		return false;
+	}
+
+	handle->rx_state = UART_STATE_READY;
+	handle->tx_state = UART_STATE_READY;
+
+	/*Publish the handle before the vector can use it*/
+	uart_handles[uart] = handle;
+	NVIC_EnableIRQ(instance->irq);
+
+	return true;
+}
+
+/**
+	* @brief  Disables a UART module and unbinds its handle
+	* @param  uart : UART module of type "uart_number"
+	* @retval None
+	*/
+void hal_uart_port_close(uart_number uart){
+
+	const uart_instance_t *instance = &uart_instances[uart];
+
+	NVIC_DisableIRQ(instance->irq);
+	hal_uart_disable_uart_module(instance->base);
+
+	if(uart_handles[uart]){
+		uart_handles[uart]->rx_state = UART_STATE_RESET;
+		uart_handles[uart]->tx_state = UART_STATE_RESET;
+		uart_handles[uart] = 0;
+	}
+
+	bitband_clear(&SYSCTL->RCGCUART, uart);
+}
+
+/**
+	* @brief  Returns the handle bound to a UART module
+	* @param  uart : UART module of type "uart_number"
+	* @retval handle, NULL if the module is not open
+	*/
+uart_handle_t *hal_uart_port_get_handle(uart_number uart){
+	return uart_handles[uart];
+}
+
+/**
+	* @brief  Muxes the RTS / CTS pins of a module
+	* @param  uart : UART module of type "uart_number"
+	* @retval false if the module has no flow control pins
+	*/
+bool hal_uart_port_mux_flow_control(uart_number uart){
+
+	const uart_instance_t *instance = &uart_instances[uart];
+	gpio_port_number port = (gpio_port_number)instance->flow_port;
+	GPIOA_Type *GPIOx;
+	gpio_port_state_t current, target;
+
+	if(instance->flow_port == UART_NO_FLOW_PINS)
+		return false;
+
+	hal_gpio_enable_clock(port);
+	GPIOx = hal_gpio_get_port(port);
+
+	hal_gpio_port_snapshot(GPIOx, &current);
+	target = current;
+
+	hal_gpio_state_set_alt(&target, instance->rts_pin, instance->flow_mux_value);
+	hal_gpio_state_set_alt(&target, instance->cts_pin, instance->flow_mux_value);
+	target.dir = (target.dir | (1 << instance->rts_pin)) & ~(1 << instance->cts_pin);
+
+	hal_gpio_port_apply(GPIOx, &current, &target);
+
+	return true;
+}
+
+/**
+	* @brief  Puts a handle in RS-485 half-duplex mode with its DE pin
+	* @param  *handle : handle of an open module
+	* @param  port : port of the DE pin, type "gpio_port_number"
+	* @param  pin_no : DE pin number
+	* @param  active_high : true if a high level drives the bus
+	* @retval None
+	*/
+void hal_uart_port_enable_rs485(uart_handle_t *handle, gpio_port_number port, uint8_t pin_no, bool active_high){
+
+	GPIOA_Type *GPIOx;
+	gpio_port_state_t current, target;
+
+	hal_gpio_enable_clock(port);
+	GPIOx = hal_gpio_get_port(port);
+
+	/*Writes the released level while the pin is still an input*/
+	hal_uart_enable_rs485(handle, &GPIO_DATA_MASKED(GPIOx, (1 << pin_no)), active_high);
+
+	hal_gpio_port_snapshot(GPIOx, &current);
+	target = current;
+	hal_gpio_state_set_gpio(&target, pin_no, GPIO_PIN_OUTPUT_MODE);
+	hal_gpio_port_apply(GPIOx, &current, &target);
+}
+
+/**
+	* @brief  Sums the counters of every open module, e.g. for aggregate throughput
+	* @param  *totals : filled with the sums
+	* @retval number of open modules
+	*/
+uint8_t hal_uart_port_get_totals(uart_stats_t *totals){
+
+	const uart_stats_t *stats;
+	uint8_t index, open = 0;
+
+	totals->interrupts = 0;
+	totals->tx_bytes = 0;
+	totals->rx_bytes = 0;
+	totals->overrun_errors = 0;
+	totals->break_errors = 0;
+	totals->parity_errors = 0;
+	totals->framing_errors = 0;
+	totals->address_matches = 0;
+	totals->rx_throttles = 0;
+
+	for(index = 0; index < UART_INSTANCES; index++){
+
+		if(!uart_handles[index])
+			continue;
+
+		stats = &uart_handles[index]->stats;
+		totals->interrupts += stats->interrupts;
+		totals->tx_bytes += stats->tx_bytes;
+		totals->rx_bytes += stats->rx_bytes;
+		totals->overrun_errors += stats->overrun_errors;
+		totals->break_errors += stats->break_errors;
+		totals->parity_errors += stats->parity_errors;
+		totals->framing_errors += stats->framing_errors;
+		totals->address_matches += stats->address_matches;
+		totals->rx_throttles += stats->rx_throttles;
+		open++;
+	}
+
+	return open;
+}
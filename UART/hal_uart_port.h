@@ -0,0 +1,132 @@
+#ifndef HAL_UART_PORT_H
+#define HAL_UART_PORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_uart.h"
+#include "hal_gpio.h"
+
+
+/*Number of UART modules of the device*/
+#define UART_INSTANCES									(8)
+
+/*Flow control pin field of modules without U#RTS / U#CTS*/
+#define UART_NO_FLOW_PINS								(0xFF)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                  Data Structures for the UART instances                   */
+/*                                                                           */
+/*****************************************************************************/
+
+/*enum for the UART modules, also the RCGCUART / PRUART bit*/
+typedef enum{
+
+	uart_0,
+	uart_1,
+	uart_2,
+	uart_3,
+	uart_4,
+	uart_5,
+	uart_6,
+	uart_7
+}uart_number;
+
+/*Fixed resources of one UART module*/
+typedef struct{
+
+	UART0_Type		*base;									/*register base address*/
+	IRQn_Type			irq;										/*NVIC interrupt number*/
+	uint8_t				port;										/*port of the pins, type "gpio_port_number"*/
+	uint8_t				rx_pin;
+	uint8_t				tx_pin;
+	uint8_t				mux_value;							/*PMCx encoding of both pins*/
+	uint8_t				tx_dma_channel;					/*UDMA_CHx_UARTnTX*/
+	uint8_t				rx_dma_channel;					/*UDMA_CHx_UARTnRX*/
+	uint8_t				dma_encoding;						/*UDMA_ENC_UARTn*/
+	uint8_t				flow_port;							/*port of RTS / CTS, UART_NO_FLOW_PINS if none*/
+	uint8_t				rts_pin;
+	uint8_t				cts_pin;
+	uint8_t				flow_mux_value;					/*PMCx encoding of RTS / CTS*/
+
+}uart_instance_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs for the UART instances                          */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+	* @brief  Returns the fixed resources of a UART module
+	* @param  uart : UART module of type "uart_number"
+	* @retval pointer to the table entry
+	*/
+const uart_instance_t *hal_uart_port_get_instance(uart_number uart);
+
+/**
+	* @brief  Brings up a UART module and binds a handle to its interrupt
+	* Enables the UART and port clocks, muxes the pins through the port
+	* snapshot manager, attaches the rings, binds the uDMA channels when
+	* use_dma is set (hal_udma_init must have been called), writes the
+	* configuration of handle->init and enables the NVIC interrupt.
+	* UARTn_Handler then services the handle through hal_uart_handle_interrupt.
+	* @param  *handle : handle with init filled
+	* @param  uart : UART module of type "uart_number"
+	* @param  *tx_buffer : storage for the TX ring
+	* @param  tx_size : size of the TX ring, power of two
+	* @param  *rx_buffer : storage for the RX ring
+	* @param  rx_size : size of the RX ring, power of two
+	* @param  use_dma : bind the uDMA channels of the module
+	* @retval false if the baudrate cannot be generated, the module stays closed
+	*/
+bool hal_uart_port_open(uart_handle_t *handle, uart_number uart, uint8_t *tx_buffer, uint16_t tx_size,
+												uint8_t *rx_buffer, uint16_t rx_size, bool use_dma);
+
+/**
+	* @brief  Disables a UART module and unbinds its handle
+	* The pins are left muxed to the UART.
+	* @param  uart : UART module of type "uart_number"
+	* @retval None
+	*/
+void hal_uart_port_close(uart_number uart);
+
+/**
+	* @brief  Returns the handle bound to a UART module
+	* @param  uart : UART module of type "uart_number"
+	* @retval handle, NULL if the module is not open
+	*/
+uart_handle_t *hal_uart_port_get_handle(uart_number uart);
+
+/**
+	* @brief  Muxes the RTS / CTS pins of a module
+	* Only UART1 has them on the TM4C123GH6PM (PF0 / PF1). PF0 is a locked
+	* pin, the port state manager opens GPIOCR for it. Hardware flow control
+	* itself is enabled with init.flow_control.
+	* @param  uart : UART module of type "uart_number"
+	* @retval false if the module has no flow control pins
+	*/
+bool hal_uart_port_mux_flow_control(uart_number uart);
+
+/**
+	* @brief  Puts a handle in RS-485 half-duplex mode with its DE pin
+	* The pin is set to its released level before it becomes an output,
+	* the bus is never driven by accident. See hal_uart_enable_rs485.
+	* @param  *handle : handle of an open module
+	* @param  port : port of the DE pin, type "gpio_port_number"
+	* @param  pin_no : DE pin number
+	* @param  active_high : true if a high level drives the bus
+	* @retval None
+	*/
+void hal_uart_port_enable_rs485(uart_handle_t *handle, gpio_port_number port, uint8_t pin_no, bool active_high);
+
+/**
+	* @brief  Sums the counters of every open module, e.g. for aggregate throughput
+	* @param  *totals : filled with the sums
+	* @retval number of open modules
+	*/
+uint8_t hal_uart_port_get_totals(uart_stats_t *totals);
+
+#endif
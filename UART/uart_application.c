@@ -1,53 +1,73 @@
 #include "uart_application.h"
 
 
-SYSCTL_Type *sysctl = (SYSCTL_Type*)(SYSCTL_BASE);
-GPIOA_Type *gpioD = (GPIOA_Type*)(GPIO_PORT_D);
+GPIOA_Type *gpioD;
 
 uart_handle_t uart2_handle;
 
+static uint8_t uart2_tx_ring[UART_TX_RING_SIZE];
+static uint8_t uart2_rx_ring[UART_RX_RING_SIZE];
+
+/*Last configuration written to port D*/
+static gpio_port_state_t gpioD_state;
+
 /**
   * @brief  Configures the GPIO Port D for UART operation
 	* PD6 = UART Rx pin
 	* PD7 = UART Tx pin
+	* PD7 is a locked pin, hal_gpio_port_apply opens GPIOCR for it.
   * @param  void
   * @retval None
   */
 
 void uart_gpio_init(){
 	
-	/*Enable clock gating for port D*/
-	sysctl->RCGCGPIO |= (1 << port_d);
-	
-	/*Unlock the PORT D*/
-	gpioD->LOCK = 0x4C4F434B;
-	
-	/*Enables changes on PD6 and PD7*/
-	hal_gpio_enable_changes_on_pin(gpioD, UART_TX_PIN);
-	hal_gpio_enable_changes_on_pin(gpioD, UART_RX_PIN);
-	
-	/*Set alternate function for the pin PD6 and PD7*/
-	hal_gpio_set_alt_function(gpioD, UART_TX_PIN);
-	hal_gpio_set_alt_function(gpioD, UART_RX_PIN);
-	
-	/*Set UART Tx pin as output mode*/
-	hal_gpio_set_pin_mode(gpioD, UART_TX_PIN, GPIO_PIN_OUTPUT_MODE);
+	gpio_port_state_t target;
+
+	/*Enable clock gating for port D and access it through the AHB aperture*/
+	hal_gpio_enable_clock(port_d);
+	gpioD = hal_gpio_enable_ahb(port_d);
 	
-	/*Set UART Rx pin as input mode*/
-	hal_gpio_set_pin_mode(gpioD, UART_RX_PIN, GPIO_PIN_INPUT_MODE);
+	hal_gpio_port_snapshot(gpioD, &gpioD_state);
+	target = gpioD_state;
+
+	/*U2Tx and U2Rx are PMC value 1 on PD7 and PD6*/
+	hal_gpio_state_set_alt(&target, UART_TX_PIN, 1);
+	hal_gpio_state_set_alt(&target, UART_RX_PIN, 1);
+	target.dir = (target.dir | (1 << UART_TX_PIN)) & ~(1 << UART_RX_PIN);
 
 	/*Configure current level for both pin to 2 mA*/
-	hal_gpio_configure_drive_strength(gpioD, UART_TX_PIN, GPIO_PIN_DS_2MA);
-	hal_gpio_configure_drive_strength(gpioD, UART_RX_PIN, GPIO_PIN_DS_2MA);
-	
-	/*configure both pins digital functionality*/
-	hal_gpio_configure_digital_functionality(gpioD, UART_RX_PIN, GPIO_PIN_DIGITAL_ENABLE);
-	hal_gpio_configure_digital_functionality(gpioD, UART_TX_PIN, GPIO_PIN_DIGITAL_ENABLE);
-	
-	/*Configure PMC field in GPIOCTL register to for alternate functionality*/
-	hal_gpio_configure_mux_control(gpioD, UART_TX_PIN, 1);
-	hal_gpio_configure_mux_control(gpioD, UART_RX_PIN, 1);
+	target.dr2r |= (1 << UART_TX_PIN) | (1 << UART_RX_PIN);
+	target.dr4r &= ~((1 << UART_TX_PIN) | (1 << UART_RX_PIN));
+	target.dr8r &= ~((1 << UART_TX_PIN) | (1 << UART_RX_PIN));
 
+	hal_gpio_port_apply(gpioD, &gpioD_state, &target);
+}
+
+/**
+  * @brief  Switches the UART pins between UART2 and plain GPIO
+	* As GPIO, Tx is an output held at the idle (high) level and Rx an input,
+	* e.g. to clock a stuck bus free. Only AFSEL, PCTL and DIR are written.
+  * @param  uart : true for UART2, false for GPIO
+  * @retval None
+  */
+void uart_gpio_select(bool uart){
+
+	gpio_port_state_t target = gpioD_state;
+
+	if(uart){
+		hal_gpio_state_set_alt(&target, UART_TX_PIN, 1);
+		hal_gpio_state_set_alt(&target, UART_RX_PIN, 1);
+	}
+	else{
+		GPIO_DATA_MASKED(gpioD, (1 << UART_TX_PIN)) = (1 << UART_TX_PIN);
+		hal_gpio_state_set_gpio(&target, UART_TX_PIN, GPIO_PIN_OUTPUT_MODE);
+		hal_gpio_state_set_gpio(&target, UART_RX_PIN, GPIO_PIN_INPUT_MODE);
+	}
+
+	target.dir = (target.dir | (1 << UART_TX_PIN)) & ~(1 << UART_RX_PIN);
+
+	hal_gpio_port_apply(gpioD, &gpioD_state, &target);
 }
 
 /**
@@ -61,48 +81,42 @@ void uart_init(){
 	/*Configure GPIO pins for UART2*/
 	uart_gpio_init();
 	
-	uart2_handle.instance = UART2;
-	
-	/*Enable clock for UART2*/
-	sysctl->RCGCUART |= (1 << RCGCUART_CLOCK_GATING_UART2);
-	
 	uart2_handle.init.baudrate = UART_BAUDRATE_11500;				/*Configure barudrate of 115200*/
+	uart2_handle.init.clock = UART_SYS_CLOCK;								/*UART runs from the 16 MHz system clock*/
+	uart2_handle.init.high_speed = false;										/*clock / 16 sampling*/
 	uart2_handle.init.fifo_mode = UART_FIFO_ENABLED;        /*fifo mode enabled*/
 	uart2_handle.init.parity = UART_NO_PARITY;							/*NO parity checking*/
 	uart2_handle.init.stopbits = UART_ONE_STOPBIT;					/*One stopbit*/
 	uart2_handle.init.worldlength = UART_WORDLENGTH_8BIT;		/*Data in a frame is 8 bits*/
+	uart2_handle.init.tx_fifo_level = UART_FIFO_LEVEL_1_2;	/*refill TX FIFO when half empty*/
+	uart2_handle.init.rx_fifo_level = UART_FIFO_LEVEL_1_2;	/*drain RX FIFO when half full*/
+	uart2_handle.init.interrupt_mask = (1 << UARTIM_REG_RXIM_FLAG_MASK) |
+																		 (1 << UARTIM_REG_RTIM_FLAG_MASK);	/*RX and RX timeout interrupts*/
 	
-	/*Disable the UART2 module before configuring it*/
-	hal_uart_disable_uart_module(uart2_handle.instance);
+	/*The uDMA channels used by hal_uart_dma_tx / hal_uart_dma_rx are bound by the open*/
+	hal_udma_init();
 	
-	/*Initialize UART2*/
-	hal_uart_configure_baudrate(&uart2_handle);
-	hal_uart_enable_fifo(uart2_handle.instance);
-	hal_uart_disable_parity(uart2_handle.instance);
-	hal_uart_configure_stopbits(&uart2_handle);
-	hal_uart_configure_world_length(&uart2_handle);
-	
-	/*Select clock source for the UART*/
-	hal_uart_configure_clock_source(uart2_handle.instance, UART_CLOCK_SYSTEM);
-	
-	/*Enable Tx and Rx section of the UART module*/
-	hal_uart_enable_uart_Tx(uart2_handle.instance);
-	hal_uart_enable_uart_Rx(uart2_handle.instance);
-	
-	/*Enable transmission and reception for the UART2*/
-	hal_uart_enable_uart_module(uart2_handle.instance);
-	
-	/*Set the status as ready*/
-	uart2_handle.rx_state = UART_STATE_READY;
-	uart2_handle.tx_state = UART_STATE_READY;
+	/*Clock, rings, LCRH/baudrate/IFLS/IM and UART2_Handler binding in one call*/
+	hal_uart_port_open(&uart2_handle, uart_2, uart2_tx_ring, UART_TX_RING_SIZE,
+										 uart2_rx_ring, UART_RX_RING_SIZE, true);
 	
 }
 
 
 int main(void){
 
+	uint8_t data[16];
+	uint32_t len;
+
 	/*Initialize UART functionality*/
 	uart_init();
 
+	/*Echo everything received, both directions are serviced by the ISR*/
+	while(1){
+		len = hal_uart_rx(&uart2_handle, data, sizeof(data));
+		if(len)
+			hal_uart_tx(&uart2_handle, data, len);
+	}
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,221 @@
+#include "hal_udma.h"
+
+
+/*Channel control table: 32 primary structures followed by 32 alternate
+ *structures. The controller requires the table to be 1024 byte aligned.*/
+#if defined(__CC_ARM)
+static __align(1024) udma_control_t udma_control_table[2 * UDMA_NUM_CHANNELS];
+#elif defined(__ICCARM__)
+#pragma data_alignment=1024
+static udma_control_t udma_control_table[2 * UDMA_NUM_CHANNELS];
+#elif defined(__TMS470__)
+#pragma DATA_ALIGN(udma_control_table, 1024)
+static udma_control_t udma_control_table[2 * UDMA_NUM_CHANNELS];
+#else
+static udma_control_t udma_control_table[2 * UDMA_NUM_CHANNELS] __attribute__((aligned(1024)));
+#endif
+
+
+/**
+  * @brief  Enables the uDMA clock, the controller and points it to the control table
+  * @param  None
+  * @retval None
+  */
+void hal_udma_init(void){
+
+	/*Enable clock gating for the uDMA and wait until it is ready*/
+	SYSCTL->RCGCDMA |= (1 << RCGCDMA_REG_R0_FLAG_MASK);
+	while(!(SYSCTL->PRDMA & (1 << RCGCDMA_REG_R0_FLAG_MASK)));
+
+	UDMA->CFG = (1 << UDMACFG_REG_MASTEN_FLAG_MASK);
+	UDMA->CTLBASE = (uint32_t)udma_control_table;
+}
+
+/**
+  * @brief  Returns the primary or alternate control structure of a channel
+  * @param  channel_select: channel number, optionally or'ed with UDMA_ALT_SELECT
+  * @retval pointer to the control structure inside the control table
+  */
+udma_control_t *hal_udma_get_control(uint8_t channel_select){
+
+	return &udma_control_table[channel_select & ((2 * UDMA_NUM_CHANNELS) - 1)];
+}
+
+/**
+  * @brief  Selects which peripheral drives the requests of a channel
+  * @param  channel: channel number
+  * @param  encoding: CHMAP encoding of the peripheral (0 - 4)
+  * @retval None
+  */
+void hal_udma_assign_channel(uint8_t channel, uint8_t encoding){
+
+	/*CHMAP0..3 are consecutive, each holds eight 4 bit fields*/
+	volatile uint32_t *chmap = &UDMA->CHMAP0 + (channel >> 3);
+	uint32_t shift = (channel & 0x07) * 4;
+
+	*chmap = (*chmap & ~(0x0F << shift)) | ((uint32_t)encoding << shift);
+}
+
+/**
+  * @brief  Clears the burst, alternate, priority and request mask attributes of a channel
+  * @param  channel: channel number
+  * @retval None
+  */
+void hal_udma_reset_channel_attributes(uint8_t channel){
+
+	uint32_t bit = (1UL << channel);
+
+	UDMA->USEBURSTCLR = bit;
+	UDMA->ALTCLR = bit;
+	UDMA->PRIOCLR = bit;
+	UDMA->REQMASKCLR = bit;
+}
+
+/**
+  * @brief  Fills a control structure (or a scatter-gather task) for a transfer
+  * @param  control: control structure or task to fill
+  * @param  flags: item size, increments and arbitration built with UDMA_CONTROL_FLAGS
+  * @param  mode: transfer mode, one of UDMA_MODE_xxx
+  * @param  src: source start address
+  * @param  dst: destination start address
+  * @param  count: number of items, 1 to UDMA_MAX_TRANSFER
+  * @retval None
+  */
+void hal_udma_build_transfer(udma_control_t *control, uint32_t flags, uint32_t mode,
+														 volatile void *src, volatile void *dst, uint16_t count){
+
+	uint32_t src_inc = (flags >> UDMACHCTL_SRCINC_POS) & 0x03;
+	uint32_t dst_inc = (flags >> UDMACHCTL_DSTINC_POS) & 0x03;
+
+	/*The hardware wants the address of the last item, not the first one*/
+	control->src_end = (uint32_t)src;
+	if(src_inc != UDMA_INC_NONE)
+		control->src_end += (uint32_t)(count - 1) << src_inc;
+
+	control->dst_end = (uint32_t)dst;
+	if(dst_inc != UDMA_INC_NONE)
+		control->dst_end += (uint32_t)(count - 1) << dst_inc;
+
+	control->control = flags |
+										 ((uint32_t)(count - 1) << UDMACHCTL_XFERSIZE_POS) |
+										 (mode << UDMACHCTL_XFERMODE_POS);
+}
+
+/**
+  * @brief  Programs the primary or alternate structure of a channel for a transfer
+  * @param  channel_select: channel number, optionally or'ed with UDMA_ALT_SELECT
+  * @param  flags: item size, increments and arbitration built with UDMA_CONTROL_FLAGS
+  * @param  mode: transfer mode, one of UDMA_MODE_xxx
+  * @param  src: source start address
+  * @param  dst: destination start address
+  * @param  count: number of items, 1 to UDMA_MAX_TRANSFER
+  * @retval None
+  */
+void hal_udma_set_transfer(uint8_t channel_select, uint32_t flags, uint32_t mode,
+													 volatile void *src, volatile void *dst, uint16_t count){
+
+	hal_udma_build_transfer(hal_udma_get_control(channel_select), flags, mode, src, dst, count);
+}
+
+/**
+  * @brief  Programs the primary structure of a channel to run a scatter-gather task list
+	* Every task but the last one must use the alternate scatter-gather mode,
+	* the last one uses BASIC (peripheral) or AUTO (memory).
+  * @param  channel: channel number
+  * @param  tasks: task list, word aligned, must stay valid until the transfer ends
+  * @param  task_count: number of tasks, 1 to 256
+  * @param  peripheral: true for peripheral scatter-gather, false for memory scatter-gather
+  * @retval None
+  */
+void hal_udma_set_scatter_gather(uint8_t channel, udma_control_t *tasks, uint16_t task_count, bool peripheral){
+
+	udma_control_t *primary = hal_udma_get_control(channel);
+	udma_control_t *alternate = hal_udma_get_control(channel | UDMA_ALT_SELECT);
+
+	/*The primary structure copies each task, four words at a time, into the
+	 *alternate structure which then performs the actual transfer*/
+	primary->src_end = (uint32_t)&tasks[task_count - 1].spare;
+	primary->dst_end = (uint32_t)&alternate->spare;
+	primary->control = UDMA_CONTROL_FLAGS(UDMA_INC_32, UDMA_INC_32, UDMA_SIZE_32, UDMA_ARB_4) |
+										 ((uint32_t)(task_count * 4 - 1) << UDMACHCTL_XFERSIZE_POS) |
+										 (peripheral ? UDMA_MODE_PER_SCATTER_GATHER : UDMA_MODE_MEM_SCATTER_GATHER);
+}
+
+/**
+  * @brief  Returns the number of items still to be moved by a control structure
+  * @param  channel_select: channel number, optionally or'ed with UDMA_ALT_SELECT
+  * @retval remaining items, 0 when the structure has completed
+  */
+uint16_t hal_udma_get_remaining(uint8_t channel_select){
+
+	uint32_t control = hal_udma_get_control(channel_select)->control;
+
+	/*A completed structure is left in STOP mode with XFERSIZE at zero*/
+	if((control & UDMACHCTL_XFERMODE_MASK) == UDMA_MODE_STOP)
+		return 0;
+
+	return (uint16_t)(((control & UDMACHCTL_XFERSIZE_MASK) >> UDMACHCTL_XFERSIZE_POS) + 1);
+}
+
+/**
+  * @brief  Returns the transfer mode currently held by a control structure
+  * @param  channel_select: channel number, optionally or'ed with UDMA_ALT_SELECT
+  * @retval mode, UDMA_MODE_STOP once the structure has completed
+  */
+uint32_t hal_udma_get_mode(uint8_t channel_select){
+
+	return (hal_udma_get_control(channel_select)->control & UDMACHCTL_XFERMODE_MASK);
+}
+
+/**
+  * @brief  Enables a channel
+  * @param  channel: channel number
+  * @retval None
+  */
+void hal_udma_enable_channel(uint8_t channel){
+	UDMA->ENASET = (1UL << channel);
+}
+
+/**
+  * @brief  Disables a channel
+  * @param  channel: channel number
+  * @retval None
+  */
+void hal_udma_disable_channel(uint8_t channel){
+	UDMA->ENACLR = (1UL << channel);
+}
+
+/**
+  * @brief  Checks whether a channel is still enabled
+  * @param  channel: channel number
+  * @retval true while the channel has work left
+  */
+bool hal_udma_is_channel_enabled(uint8_t channel){
+	return ((UDMA->ENASET & (1UL << channel)) != 0);
+}
+
+/**
+  * @brief  Issues a software request on a channel
+  * @param  channel: channel number
+  * @retval None
+  */
+void hal_udma_request_channel(uint8_t channel){
+	UDMA->SWREQ = (1UL << channel);
+}
+
+/**
+  * @brief  Checks and clears the completion flag of a channel
+  * @param  channel: channel number
+  * @retval true if the channel completed a transfer since the last call
+  */
+bool hal_udma_channel_done(uint8_t channel){
+
+	uint32_t bit = (1UL << channel);
+
+	if(UDMA->CHIS & bit){
+		UDMA->CHIS = bit;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,264 @@
+#ifndef HAL_UDMA_H
+#define HAL_UDMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+
+
+/***************************************************************************************/
+/*                                                                                     */
+/*					Register Bit Definitions                                                   */
+/*                                                                                     */
+/***************************************************************************************/
+
+/*Bit definitions for DMACFG register*/
+#define UDMACFG_REG_MASTEN_FLAG_MASK										(0)
+
+/*Bit definitions for RCGCDMA / PRDMA register*/
+#define RCGCDMA_REG_R0_FLAG_MASK												(0)
+
+/*Bit positions of the fields in the channel control word*/
+#define UDMACHCTL_DSTINC_POS														(30)
+#define UDMACHCTL_DSTSIZE_POS														(28)
+#define UDMACHCTL_SRCINC_POS														(26)
+#define UDMACHCTL_SRCSIZE_POS														(24)
+#define UDMACHCTL_ARBSIZE_POS														(14)
+#define UDMACHCTL_XFERSIZE_POS													(4)
+#define UDMACHCTL_NXTUSEBURST_POS												(3)
+#define UDMACHCTL_XFERMODE_POS													(0)
+
+#define UDMACHCTL_XFERSIZE_MASK													(0x3FF << UDMACHCTL_XFERSIZE_POS)
+#define UDMACHCTL_XFERMODE_MASK													(0x7 << UDMACHCTL_XFERMODE_POS)
+
+
+/*Number of channels and the largest transfer of a single control structure*/
+#define UDMA_NUM_CHANNELS																(32)
+#define UDMA_MAX_TRANSFER																(1024)
+
+/*Or'ed with a channel number to select its alternate control structure*/
+#define UDMA_ALT_SELECT																	(0x20)
+
+/*Data item size*/
+#define UDMA_SIZE_8																			(0)
+#define UDMA_SIZE_16																		(1)
+#define UDMA_SIZE_32																		(2)
+
+/*Address increment*/
+#define UDMA_INC_8																			(0)
+#define UDMA_INC_16																			(1)
+#define UDMA_INC_32																			(2)
+#define UDMA_INC_NONE																		(3)
+
+/*Arbitration size, number of items moved before re-arbitrating*/
+#define UDMA_ARB_1																			(0)
+#define UDMA_ARB_2																			(1)
+#define UDMA_ARB_4																			(2)
+#define UDMA_ARB_8																			(3)
+#define UDMA_ARB_16																			(4)
+#define UDMA_ARB_32																			(5)
+#define UDMA_ARB_64																			(6)
+#define UDMA_ARB_128																		(7)
+#define UDMA_ARB_256																		(8)
+#define UDMA_ARB_512																		(9)
+#define UDMA_ARB_1024																		(10)
+
+/*Transfer modes*/
+#define UDMA_MODE_STOP																	(0)
+#define UDMA_MODE_BASIC																	(1)
+#define UDMA_MODE_AUTO																	(2)
+#define UDMA_MODE_PINGPONG															(3)
+#define UDMA_MODE_MEM_SCATTER_GATHER										(4)
+#define UDMA_MODE_ALT_MEM_SCATTER_GATHER								(5)
+#define UDMA_MODE_PER_SCATTER_GATHER										(6)
+#define UDMA_MODE_ALT_PER_SCATTER_GATHER								(7)
+
+/*Builds the item size / increment / arbitration part of a control word*/
+#define UDMA_CONTROL_FLAGS(dst_inc, src_inc, size, arb)																\
+				(((uint32_t)(dst_inc) << UDMACHCTL_DSTINC_POS) | ((uint32_t)(size) << UDMACHCTL_DSTSIZE_POS) |	\
+				 ((uint32_t)(src_inc) << UDMACHCTL_SRCINC_POS) | ((uint32_t)(size) << UDMACHCTL_SRCSIZE_POS) |	\
+				 ((uint32_t)(arb) << UDMACHCTL_ARBSIZE_POS))
+
+
+/*Peripheral channel assignments (channel number, CHMAP encoding)*/
+#define UDMA_CH8_UART0RX																(8)
+#define UDMA_CH9_UART0TX																(9)
+#define UDMA_CH22_UART1RX																(22)
+#define UDMA_CH23_UART1TX																(23)
+#define UDMA_CH12_UART2RX																(12)
+#define UDMA_CH13_UART2TX																(13)
+#define UDMA_CH16_UART3RX																(16)
+#define UDMA_CH17_UART3TX																(17)
+#define UDMA_CH18_UART4RX																(18)
+#define UDMA_CH19_UART4TX																(19)
+#define UDMA_CH6_UART5RX																(6)
+#define UDMA_CH7_UART5TX																(7)
+#define UDMA_CH10_UART6RX																(10)
+#define UDMA_CH11_UART6TX																(11)
+#define UDMA_CH20_UART7RX																(20)
+#define UDMA_CH21_UART7TX																(21)
+
+#define UDMA_ENC_UART0																	(0)
+#define UDMA_ENC_UART1																	(0)
+#define UDMA_ENC_UART2																	(1)
+#define UDMA_ENC_UART3																	(2)
+#define UDMA_ENC_UART4																	(2)
+#define UDMA_ENC_UART5																	(2)
+#define UDMA_ENC_UART6																	(2)
+#define UDMA_ENC_UART7																	(2)
+
+/*Channel reserved for software (memory to memory) requests*/
+#define UDMA_CH30_SW																		(30)
+#define UDMA_ENC_SW																			(0)
+
+/*GPIO ports request on these channels when their GPIODMACTL bits are set*/
+#define UDMA_CH4_GPIOA																	(4)
+#define UDMA_CH5_GPIOB																	(5)
+#define UDMA_CH6_GPIOC																	(6)
+#define UDMA_CH7_GPIOD																	(7)
+#define UDMA_CH14_GPIOE																	(14)
+#define UDMA_CH15_GPIOF																	(15)
+
+#define UDMA_ENC_GPIO																		(3)
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*                        Data Structures for uDMA                           */
+/*                                                                           */
+/*****************************************************************************/
+
+/*Channel control structure, the layout is fixed by the hardware*/
+typedef struct{
+
+	volatile uint32_t	src_end;						/*address of the last source item*/
+	volatile uint32_t	dst_end;						/*address of the last destination item*/
+	volatile uint32_t	control;						/*channel control word*/
+	volatile uint32_t	spare;							/*unused by the hardware, also ends a scatter-gather task*/
+
+}udma_control_t;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*                       APIs to use uDMA                                     */
+/*                                                                            */
+/******************************************************************************/
+
+/**
+  * @brief  Enables the uDMA clock, the controller and points it to the control table
+  * @param  None
+  * @retval None
+  */
+void hal_udma_init(void);
+
+/**
+  * @brief  Returns the primary or alternate control structure of a channel
+  * @param  channel_select: channel number, optionally or'ed with UDMA_ALT_SELECT
+  * @retval pointer to the control structure inside the control table
+  */
+udma_control_t *hal_udma_get_control(uint8_t channel_select);
+
+/**
+  * @brief  Selects which peripheral drives the requests of a channel
+  * @param  channel: channel number
+  * @param  encoding: CHMAP encoding of the peripheral (0 - 4)
+  * @retval None
+  */
+void hal_udma_assign_channel(uint8_t channel, uint8_t encoding);
+
+/**
+  * @brief  Clears the burst, alternate, priority and request mask attributes of a channel
+  * @param  channel: channel number
+  * @retval None
+  */
+void hal_udma_reset_channel_attributes(uint8_t channel);
+
+/**
+  * @brief  Fills a control structure (or a scatter-gather task) for a transfer
+  * @param  control: control structure or task to fill
+  * @param  flags: item size, increments and arbitration built with UDMA_CONTROL_FLAGS
+  * @param  mode: transfer mode, one of UDMA_MODE_xxx
+  * @param  src: source start address
+  * @param  dst: destination start address
+  * @param  count: number of items, 1 to UDMA_MAX_TRANSFER
+  * @retval None
+  */
+void hal_udma_build_transfer(udma_control_t *control, uint32_t flags, uint32_t mode,
+														 volatile void *src, volatile void *dst, uint16_t count);
+
+/**
+  * @brief  Programs the primary or alternate structure of a channel for a transfer
+  * @param  channel_select: channel number, optionally or'ed with UDMA_ALT_SELECT
+  * @param  flags: item size, increments and arbitration built with UDMA_CONTROL_FLAGS
+  * @param  mode: transfer mode, one of UDMA_MODE_xxx
+  * @param  src: source start address
+  * @param  dst: destination start address
+  * @param  count: number of items, 1 to UDMA_MAX_TRANSFER
+  * @retval None
+  */
+void hal_udma_set_transfer(uint8_t channel_select, uint32_t flags, uint32_t mode,
+													 volatile void *src, volatile void *dst, uint16_t count);
+
+/**
+  * @brief  Programs the primary structure of a channel to run a scatter-gather task list
+	* Every task but the last one must use the alternate scatter-gather mode,
+	* the last one uses BASIC (peripheral) or AUTO (memory).
+  * @param  channel: channel number
+  * @param  tasks: task list, word aligned, must stay valid until the transfer ends
+  * @param  task_count: number of tasks, 1 to 256
+  * @param  peripheral: true for peripheral scatter-gather, false for memory scatter-gather
+  * @retval None
+  */
+void hal_udma_set_scatter_gather(uint8_t channel, udma_control_t *tasks, uint16_t task_count, bool peripheral);
+
+/**
+  * @brief  Returns the number of items still to be moved by a control structure
+  * @param  channel_select: channel number, optionally or'ed with UDMA_ALT_SELECT
+  * @retval remaining items, 0 when the structure has completed
+  */
+uint16_t hal_udma_get_remaining(uint8_t channel_select);
+
+/**
+  * @brief  Returns the transfer mode currently held by a control structure
+  * @param  channel_select: channel number, optionally or'ed with UDMA_ALT_SELECT
+  * @retval mode, UDMA_MODE_STOP once the structure has completed
+  */
+uint32_t hal_udma_get_mode(uint8_t channel_select);
+
+/**
+  * @brief  Enables a channel
+  * @param  channel: channel number
+  * @retval None
+  */
+void hal_udma_enable_channel(uint8_t channel);
+
+/**
+  * @brief  Disables a channel
+  * @param  channel: channel number
+  * @retval None
+  */
+void hal_udma_disable_channel(uint8_t channel);
+
+/**
+  * @brief  Checks whether a channel is still enabled
+  * @param  channel: channel number
+  * @retval true while the channel has work left
+  */
+bool hal_udma_is_channel_enabled(uint8_t channel);
+
+/**
+  * @brief  Issues a software request on a channel
+  * @param  channel: channel number
+  * @retval None
+  */
+void hal_udma_request_channel(uint8_t channel);
+
+/**
+  * @brief  Checks and clears the completion flag of a channel
+  * @param  channel: channel number
+  * @retval true if the channel completed a transfer since the last call
+  */
+bool hal_udma_channel_done(uint8_t channel);
+
+#endif
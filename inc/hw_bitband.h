@@ -0,0 +1,59 @@
+#ifndef HW_BITBAND_H
+#define HW_BITBAND_H
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+#include "hw_types.h"
+
+/*Typed access to single register bits through the peripheral bit-band alias
+ *(0x42000000 - 0x43FFFFFF mirrors every bit of 0x40000000 - 0x400FFFFF).
+ *A store to an alias word is one atomic bus operation, so it cannot be torn
+ *by an ISR updating another bit of the same register. The SRAM alias
+ *(0x22000000) works the same way for flags shared with an ISR.
+ *
+ *Do not use it on registers where a read has side effects (UARTDR, SSIDR)
+ *or on the GPIO DATA window; use GPIO_DATA_MASKED for the latter.*/
+
+
+/**
+  * @brief  Sets one bit of a peripheral register
+  * @param  reg: address of the register
+  * @param  bit: bit number
+  * @retval None
+  */
+__STATIC_INLINE void bitband_set(volatile uint32_t *reg, uint32_t bit){
+	HWREGBITW(reg, bit) = 1;
+}
+
+/**
+  * @brief  Clears one bit of a peripheral register
+  * @param  reg: address of the register
+  * @param  bit: bit number
+  * @retval None
+  */
+__STATIC_INLINE void bitband_clear(volatile uint32_t *reg, uint32_t bit){
+	HWREGBITW(reg, bit) = 0;
+}
+
+/**
+  * @brief  Writes one bit of a peripheral register
+  * @param  reg: address of the register
+  * @param  bit: bit number
+  * @param  value: 0 clears the bit, anything else sets it
+  * @retval None
+  */
+__STATIC_INLINE void bitband_write(volatile uint32_t *reg, uint32_t bit, uint32_t value){
+	HWREGBITW(reg, bit) = (value != 0);
+}
+
+/**
+  * @brief  Reads one bit of a peripheral register
+  * @param  reg: address of the register
+  * @param  bit: bit number
+  * @retval 0 or 1
+  */
+__STATIC_INLINE uint32_t bitband_read(const volatile uint32_t *reg, uint32_t bit){
+	return HWREGBITW(reg, bit);
+}
+
+#endif
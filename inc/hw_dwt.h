@@ -0,0 +1,42 @@
+#ifndef HW_DWT_H
+#define HW_DWT_H
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+/*Free running 32 bit core clock counter of the DWT unit. It counts every
+ *CPU cycle, wraps after 2^32 cycles (~53 s at 80 MHz); differences of two
+ *readings taken with unsigned arithmetic stay correct across one wrap.*/
+
+
+/**
+  * @brief  Enables the DWT cycle counter, harmless if already running
+  * @param  None
+  * @retval None
+  */
+__STATIC_INLINE void dwt_cycle_counter_init(void){
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+  * @brief  Returns the current cycle count
+  * @param  None
+  * @retval cycle count
+  */
+__STATIC_INLINE uint32_t dwt_cycles(void){
+	return DWT->CYCCNT;
+}
+
+/**
+  * @brief  Busy waits until "cycles" core cycles elapsed since "start"
+  * @param  start: cycle count returned by dwt_cycles
+  * @param  cycles: cycles to wait, less than 2^31
+  * @retval None
+  */
+__STATIC_INLINE void dwt_wait_until(uint32_t start, uint32_t cycles){
+	while((uint32_t)(DWT->CYCCNT - start) < cycles);
+}
+
+#endif
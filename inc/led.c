@@ -4,7 +4,7 @@
 
 /*Sample application to test the GPIO driver code*/
 
-GPIOA_Type *GPIOx = (GPIOA_Type*)GPIO_PORT_F;
+GPIOA_Type *GPIOx;
 
 
 /*function to turn led on*/
@@ -17,48 +17,118 @@ void led_off(GPIOA_Type *GPIOx, int32_t pin_no){
 	hal_gpio_write_to_pin(GPIOx, pin_no, 0);
 }
 
-/*GPIO port f IRQ handler*/
-void GPIOF_Handler(void){
-	hal_gpio_clear_interrupt(GPIOx, SWITCH_SW2_PIN);
-	led_off(GPIOx, LED_RED_PIN);
+/*Software PWM of the three LEDs and the effect each one plays*/
+static gpio_pwm_t led_pwm;
+static led_command_t led_commands[LED_NUM_CHANNELS];
+static uint32_t led_last_frame;
+
+/*PWM timer handler, one port write per edge*/
+void TIMER0A_Handler(void){
+	hal_gpio_pwm_handle_interrupt(&led_pwm);
 }
 
+/*function to set a steady brightness, 0 - GPIO_PWM_MAX_DUTY*/
+void led_set_brightness(uint8_t led, uint8_t level){
+	led_commands[led].effect = LED_EFFECT_STEADY;
+	led_commands[led].level = level;
+}
 
-/*function to initialize led and switch pin of port f*/
-void led_switch_init(){
+/*function to blink a led, times in ms*/
+void led_blink(uint8_t led, uint8_t level, uint16_t on_ms, uint16_t off_ms){
+	led_commands[led].on_frames = LED_MS_TO_FRAMES(on_ms);
+	led_commands[led].off_frames = LED_MS_TO_FRAMES(off_ms);
+	led_commands[led].start = led_pwm.frames;
+	led_commands[led].level = level;
+	led_commands[led].effect = LED_EFFECT_BLINK;
+}
+
+/*function to fade a led in and out, period in ms*/
+void led_breathe(uint8_t led, uint8_t level, uint16_t period_ms){
+	led_commands[led].on_frames = LED_MS_TO_FRAMES(period_ms / 2);
+	led_commands[led].off_frames = led_commands[led].on_frames;
+	led_commands[led].start = led_pwm.frames;
+	led_commands[led].level = level;
+	led_commands[led].effect = LED_EFFECT_BREATHE;
+}
+
+/*function to advance the effects, once per PWM period at most*/
+void led_service(void){
 	
+	uint32_t frame = led_pwm.frames;
+	uint32_t elapsed, cycle, ramp;
+	led_command_t *command;
+	uint8_t led, duty;
 	
-	gpio_pin_config_t led_pin_config, switch_pin_config;
+	if(frame == led_last_frame)
+		return;
 	
+	for(led = 0; led < LED_NUM_CHANNELS; led++){
+		
+		command = &led_commands[led];
+		cycle = command->on_frames + command->off_frames;
+		elapsed = (frame - command->start) % (cycle ? cycle : 1);
+		
+		switch(command->effect){
+			case LED_EFFECT_BLINK:
+				duty = (elapsed < command->on_frames) ? command->level : 0;
+				break;
+			
+			case LED_EFFECT_BREATHE:
+				/*Triangle ramp, squared for a perceptually even fade*/
+				ramp = (elapsed <= command->on_frames) ? elapsed : (2 * command->on_frames - elapsed);
+				ramp = command->on_frames ? (ramp * 255) / command->on_frames : 255;
+				duty = (uint8_t)((command->level * ramp * ramp) / (255 * 255));
+				break;
+			
+			default:
+				duty = command->level;
+				break;
+		}
+		
+		hal_gpio_pwm_set_duty(&led_pwm, led, duty);
+	}
 	
-	/*Enable clock for PottF*/
-	SYSCTL_Type *sysctl = (SYSCTL_Type*)SYSCTL_BASE;
-	sysctl->RCGCGPIO |= (1 << port_f);
+	/*Retried next period if the ISR has not taken the previous schedule yet*/
+	if(hal_gpio_pwm_update(&led_pwm))
+		led_last_frame = frame;
+}
+
+/*Periodic tick of the switch debouncing service*/
+void SysTick_Handler(void){
+	hal_gpio_debounce_tick();
+}
+
+
+/*Board pins: LED outputs and switch 2 input with pull-up, its edges belong to the debouncer*/
+static const gpio_board_pin_t board_pins[] = {
+	/*port		pin							mode									alt		drive							register						digital										interrupt*/
+	{port_f,	LED_RED_PIN,		GPIO_PIN_OUTPUT_MODE,	0,		GPIO_PIN_DS_2MA,	GPIO_PIN_NO_PULL,		GPIO_PIN_DIGITAL_ENABLE,	GPIO_PIN_INT_NONE},
+	{port_f,	LED_BLUE_PIN,		GPIO_PIN_OUTPUT_MODE,	0,		GPIO_PIN_DS_2MA,	GPIO_PIN_NO_PULL,		GPIO_PIN_DIGITAL_ENABLE,	GPIO_PIN_INT_NONE},
+	{port_f,	LED_GREEN_PIN,	GPIO_PIN_OUTPUT_MODE,	0,		GPIO_PIN_DS_2MA,	GPIO_PIN_NO_PULL,		GPIO_PIN_DIGITAL_ENABLE,	GPIO_PIN_INT_NONE},
+	{port_f,	SWITCH_SW2_PIN,	GPIO_PIN_INPUT_MODE,	0,		GPIO_PIN_DS_2MA,	GPIO_PIN_PULL_UP,		GPIO_PIN_DIGITAL_ENABLE,	GPIO_PIN_INT_NONE},
+};
+
+
+/*PWM channel order: LED_RED, LED_BLUE, LED_GREEN*/
+static const uint8_t led_pins[LED_NUM_CHANNELS] = { LED_RED_PIN, LED_BLUE_PIN, LED_GREEN_PIN };
+
+
+/*function to initialize led and switch pin of port f*/
+void led_switch_init(){
 	
-	/*unlock PortF*/
-	GPIOx->LOCK = 0x4C4F434B;
+	/*Access PortF through the AHB aperture*/
+	GPIOx = hal_gpio_enable_ahb(port_f);
 	
-	/*Allow changes to PF0 and PF1*/
-	GPIOx->CR = 0x03;
+	/*Clock, unlock of PF0 and every pin register in one pass per port*/
+	hal_gpio_init_table(board_pins, sizeof(board_pins) / sizeof(board_pins[0]));
 	
-	/*Configure led pin*/
-	led_pin_config.pin = LED_RED_PIN;
-	led_pin_config.mode = GPIO_PIN_OUTPUT_MODE;
-	led_pin_config.digital = GPIO_PIN_DIGITAL_ENABLE;
-	hal_gpio_init(GPIOx, &led_pin_config);
+	/*Switch 2 costs one interrupt per press, the rest is sampled from SysTick*/
+	hal_gpio_debounce_init(LONG_PRESS_TICKS);
+	hal_gpio_debounce_add(port_f, SWITCH_SW2_PIN, true);
+	SysTick_Config(SystemCoreClock / DEBOUNCE_TICK_HZ);
 	
-	/*Configure switch pin*/
-	switch_pin_config.pin = SWITCH_SW2_PIN;
-	switch_pin_config.mode = GPIO_PIN_INPUT_MODE;
-	switch_pin_config.digital = GPIO_PIN_DIGITAL_ENABLE;
-	hal_gpio_init(GPIOx, &switch_pin_config);
-
-	/*Configure falling edge interrupt on Switch 2*/
-	hal_gpio_configure_register(GPIOx, SWITCH_SW2_PIN, GPIO_PIN_PULL_UP);
-	hal_gpio_configure_interrupt_type(GPIOx, SWITCH_SW2_PIN, EDGE_TRIGGRED_INTERRUPT);
-	hal_gpio_configure_edge_interrupt(GPIOx, SWITCH_SW2_PIN, INT_FALLING_EDGE);
-	hal_gpio_enable_interrupt(GPIOx, SWITCH_SW2_PIN, GPIOF_IRQn);
-
+	/*LEDs are driven by the software PWM from now on*/
+	hal_gpio_pwm_init(&led_pwm, port_f, led_pins, LED_NUM_CHANNELS, LED_PWM_TIMER, SystemCoreClock, LED_PWM_HZ);
 
 	/*Enable global interrupt*/
 	IntMasterEnable();
@@ -67,13 +137,34 @@ void led_switch_init(){
 
 int main(void){
 	
-	//int32_t status = 0;
+	gpio_button_event_t event;
+	uint8_t effect = LED_EFFECT_BREATHE;
+	
 	led_switch_init();
+	led_breathe(LED_RED, GPIO_PWM_MAX_DUTY, 2000);
 	
 	while(1){
-			led_on(GPIOx, LED_RED_PIN);
+		
+		/*Every interrupt (PWM edge, debounce tick) wakes the core up*/
+		CPUwfi();
+		
+		/*Switch 2 cycles the red LED through steady, blink and breathing*/
+		while(hal_gpio_debounce_get_event(&event)){
+			if(event.type != BUTTON_PRESS)
+				continue;
+			
+			effect = (effect == LED_EFFECT_BREATHE) ? LED_EFFECT_STEADY : (effect + 1);
+			
+			if(effect == LED_EFFECT_STEADY)
+				led_set_brightness(LED_RED, GPIO_PWM_MAX_DUTY / 4);
+			else if(effect == LED_EFFECT_BLINK)
+				led_blink(LED_RED, GPIO_PWM_MAX_DUTY, 250, 250);
+			else
+				led_breathe(LED_RED, GPIO_PWM_MAX_DUTY, 2000);
+		}
+		
+		led_service();
 	}
 	
 	return 0;
 }
-